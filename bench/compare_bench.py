@@ -0,0 +1,76 @@
+import json
+import sys
+import argparse
+
+
+# Metrics compared between runs and whether higher values are better
+METRICS = {
+    "median_ms": False,
+    "p95_ms": False,
+    "nodes_expanded_per_sec": True,
+    "avg_memory_bytes": False,
+}
+
+
+def load_benchmarks(filename):
+    with open(filename, "r") as file:
+        results = json.load(file)
+
+    return {benchmark["name"]: benchmark for benchmark in results["benchmarks"]}
+
+
+def relative_change(baseline, contender):
+    if baseline == 0:
+        return 0.0
+    return (contender - baseline) / baseline
+
+
+def compare(baseline_filename, contender_filename, threshold):
+    # Returns the names of the failed benchmarks, which regressed, changed their amount of solutions
+    # or are missing from the contender
+    baseline = load_benchmarks(baseline_filename)
+    contender = load_benchmarks(contender_filename)
+
+    failures = []
+    name_width = max([len("benchmark")] + [len(name) for name in baseline])
+    print(f"{'benchmark':<{name_width}} " + " ".join(f"{metric:>24}" for metric in METRICS))
+    for name in baseline:
+        if name not in contender:
+            print(f"{name:<{name_width}} missing from {contender_filename}  FAILURE")
+            failures.append(name)
+            continue
+
+        columns = []
+        regressed = False
+        for metric, higher_is_better in METRICS.items():
+            change = relative_change(baseline[name][metric], contender[name][metric])
+            worse = (-change if higher_is_better else change) > threshold
+            regressed = regressed or worse
+            columns.append(f"{change*100:>+22.1f}%{'!' if worse else ' '}")
+
+        # A different amount of solutions means the searches disagree, whatever their speed
+        changed_solutions = baseline[name]["solutions"] != contender[name]["solutions"]
+        if changed_solutions:
+            columns.append(f"solutions {baseline[name]['solutions']} -> {contender[name]['solutions']}")
+
+        status = "  SOLUTIONS CHANGED" if changed_solutions else ("  REGRESSION" if regressed else "")
+        print(f"{name:<{name_width}} " + " ".join(columns) + status)
+        if regressed or changed_solutions:
+            failures.append(name)
+
+    return failures
+
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser(description="Compare two benchmark result files and flag regressions")
+    parser.add_argument("baseline_filename")
+    parser.add_argument("contender_filename")
+    parser.add_argument("--threshold", type=float, default=0.05,
+                        help="Relative change of a metric that counts as a regression")
+
+    args = parser.parse_args()
+    failures = compare(args.baseline_filename, args.contender_filename, args.threshold)
+    if len(failures) != 0:
+        print(f"{len(failures)} failed benchmarks")
+        sys.exit(1)
@@ -0,0 +1,462 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <ctime>
+#include <thread>
+#include <string>
+#include <vector>
+
+#include "../src/Utils/Definitions.h"
+#include "../src/Utils/IOUtils.h"
+#include "../src/Utils/SearchWorkspace.h"
+#include "../src/Utils/SearchStats.h"
+#include "../src/Utils/VertexOrder.h"
+#include "../src/BiCriteria/BOAStar.h"
+#include "../src/BiCriteria/PPA.h"
+#include "../src/BiCriteria/ParallelPPA.h"
+#include "../src/Example/ShortestPathHeuristic.h"
+#include "../src/Example/LandmarkHeuristic.h"
+#include "../src/Example/LazyShortestPathHeuristic.h"
+#include "../src/Example/HierarchyQuery.h"
+
+// Benchmark of BOAStar and PPA over the bundled query sets.
+// Every query is searched warmup times and then repetitions times, and the latency of a query
+// is the median of its repetitions. The heuristic is computed once per query, outside the timing,
+// and its setup time is reported separately. Landmark tables are loaded from USA-road-MAP.landmarks
+// next to the gr files, and are built on first use. The Lazy heuristic finishes its Dijkstras
+// during the search, so that part is included in the search latency.
+// The Hierarchy heuristic searches the query graph of a contraction hierarchy loaded from
+// USA-road-MAP.hierarchy, built on first use, and its setup is building the query graph.
+// --order renumbers the vertices of every map before benchmarking it, the coordinates of the hilbert
+// order are read from USA-road-d.MAP.co. The benchmark names don't change with the order, so
+// compare_bench.py compares the runs of two orders.
+// Results are written as JSON, compare_bench.py compares two such files.
+// ParallelPPA runs once per amount of threads, which gives its scaling curve.
+
+struct BenchOptions {
+    std::string                 resource_path   = "src/Example/Resources/";
+    std::vector<std::string>    maps            = {"BAY", "COL", "NE", "NY"};
+    std::vector<std::string>    algorithms      = {"BOAStar", "PPA"};
+    std::vector<double>         eps_list        = {0, 0.01, 0.05};
+    std::vector<size_t>         threads_list;   // ParallelPPA only, defaults to 1,2,4,... up to all cores
+    std::vector<std::string>    heuristics      = {"ShortestPath"};
+    size_t                      landmarks       = 8;
+    size_t                      warmup          = 1;
+    size_t                      repetitions     = 5;
+    size_t                      max_queries     = 0; // 0 runs all the queries of a map
+    std::string                 order           = "none"; // Vertex order, "none", "bfs" or "hilbert"
+    std::string                 output          = "bench_results.json";
+};
+
+// A single algorithm and eps over all the queries of a map
+struct BenchCase {
+    std::string             map;
+    std::string             algorithm;
+    double                  eps;
+    size_t                  threads = 1;
+    std::string             heuristic;
+    double                  heuristic_seconds = 0; // Sum of the per query heuristic setup times
+    double                  preprocessing_seconds = 0; // Landmark table or hierarchy build or load, once per map
+    size_t                  preprocessing_bytes = 0;   // Size of the landmark table or hierarchy
+    std::vector<double>     latencies_ms;       // Median latency per query
+    std::vector<double>     first_solution_ms;  // Time to the first final solution per query, BOAStar and PPA only
+    size_t                  nodes_expanded = 0;
+    double                  search_seconds = 0; // Sum of the median latencies
+    std::vector<size_t>     memory_bytes;       // Peak search memory per query
+    size_t                  solutions = 0;
+};
+
+
+std::vector<std::string> split_list(const std::string &list) {
+    std::vector<std::string> items;
+    std::stringstream stream(list);
+    std::string item;
+    while (std::getline(stream, item, ',')) {
+        if (item.empty() == false) {
+            items.push_back(item);
+        }
+    }
+    return items;
+}
+
+
+bool parse_options(int argc, char **argv, BenchOptions &options) {
+    for (int i = 1; i < argc; i += 2) {
+        std::string option = argv[i];
+        if (i+1 >= argc) {
+            std::cerr << "Missing value for " << option << std::endl;
+            return false;
+        }
+        std::string value = argv[i+1];
+
+        if (option == "--resources") {
+            options.resource_path = value;
+        } else if (option == "--maps") {
+            options.maps = split_list(value);
+        } else if (option == "--algorithms") {
+            options.algorithms = split_list(value);
+        } else if (option == "--eps") {
+            options.eps_list.clear();
+            std::vector<std::string> eps_list = split_list(value);
+            for (auto eps = eps_list.begin(); eps != eps_list.end(); ++eps) {
+                options.eps_list.push_back(std::stod(*eps));
+            }
+        } else if (option == "--threads") {
+            options.threads_list.clear();
+            std::vector<std::string> threads_list = split_list(value);
+            for (auto threads = threads_list.begin(); threads != threads_list.end(); ++threads) {
+                options.threads_list.push_back(std::max<unsigned long>(1, std::stoul(*threads)));
+            }
+        } else if (option == "--heuristics") {
+            options.heuristics = split_list(value);
+        } else if (option == "--landmarks") {
+            options.landmarks = std::max<size_t>(1, std::stoul(value));
+        } else if (option == "--warmup") {
+            options.warmup = std::stoul(value);
+        } else if (option == "--repetitions") {
+            options.repetitions = std::max<size_t>(1, std::stoul(value));
+        } else if (option == "--queries") {
+            options.max_queries = std::stoul(value);
+        } else if (option == "--order") {
+            options.order = value;
+        } else if (option == "--output") {
+            options.output = value;
+        } else {
+            std::cerr << "Unknown option " << option << std::endl;
+            return false;
+        }
+    }
+
+    for (auto algorithm = options.algorithms.begin(); algorithm != options.algorithms.end(); ++algorithm) {
+        if ((*algorithm != "BOAStar") && (*algorithm != "PPA") && (*algorithm != "ParallelPPA")) {
+            std::cerr << "Unknown algorithm " << *algorithm << std::endl;
+            return false;
+        }
+    }
+    for (auto heuristic = options.heuristics.begin(); heuristic != options.heuristics.end(); ++heuristic) {
+        if ((*heuristic != "ShortestPath") && (*heuristic != "Landmark") && (*heuristic != "Lazy") &&
+            (*heuristic != "Hierarchy")) {
+            std::cerr << "Unknown heuristic " << *heuristic << std::endl;
+            return false;
+        }
+    }
+
+    // The lazy heuristic extends its Dijkstras when called, so the ParallelPPA workers can't share it
+    bool parallel_ppa = std::find(options.algorithms.begin(), options.algorithms.end(), "ParallelPPA") != options.algorithms.end();
+    bool lazy = std::find(options.heuristics.begin(), options.heuristics.end(), "Lazy") != options.heuristics.end();
+    if (parallel_ppa && lazy) {
+        std::cerr << "ParallelPPA is not benchmarked with the Lazy heuristic, which is not thread safe" << std::endl;
+    }
+
+    if ((options.order != "none") && (options.order != "bfs") && (options.order != "hilbert")) {
+        std::cerr << "Unknown order " << options.order << std::endl;
+        return false;
+    }
+
+    if (options.threads_list.empty()) {
+        size_t cores = std::max<size_t>(1, std::thread::hardware_concurrency());
+        for (size_t threads = 1; threads < cores; threads *= 2) {
+            options.threads_list.push_back(threads);
+        }
+        options.threads_list.push_back(cores);
+    }
+    return true;
+}
+
+
+// Nearest rank percentile
+double percentile(std::vector<double> values, double fraction) {
+    if (values.empty()) {
+        return 0;
+    }
+    std::sort(values.begin(), values.end());
+    size_t rank = static_cast<size_t>(std::ceil(fraction*values.size()));
+    return values[std::max<size_t>(rank, 1)-1];
+}
+
+
+template<typename Search, typename HeuristicT>
+void run_query(Search &search, size_t source, size_t target, const HeuristicT &heuristic,
+               SearchWorkspace &workspace, const BenchOptions &options, BenchCase &bench_case) {
+    std::vector<double> latencies_ms;
+    SolutionSet solutions;
+    for (size_t run = 0; run < options.warmup+options.repetitions; run++) {
+        // Every run starts from the heuristic as constructed, lazy heuristics are extended by the search
+        HeuristicT run_heuristic(heuristic);
+        solutions.clear();
+        TimePoint start_time = Clock::now();
+        search(source, target, run_heuristic, solutions, workspace);
+        double latency_ms = std::chrono::duration<double, std::milli>(Clock::now() - start_time).count();
+        if (run >= options.warmup) {
+            latencies_ms.push_back(latency_ms);
+        }
+    }
+
+    double latency_ms = percentile(latencies_ms, 0.5);
+    bench_case.latencies_ms.push_back(latency_ms);
+    bench_case.first_solution_ms.push_back(search.get_stats().first_solution_ns/1e6);
+    bench_case.search_seconds += latency_ms/1000;
+    bench_case.nodes_expanded += search.get_stats().nodes_expanded;
+    bench_case.memory_bytes.push_back(search.get_stats().peak_memory_bytes);
+    bench_case.solutions += solutions.size();
+    bench_case.heuristic_seconds += heuristic.get_compute_time_ns()/1e9;
+}
+
+
+template<typename HeuristicT>
+void run_case(const AdjacencyMatrix &graph, size_t source, size_t target, const HeuristicT &heuristic,
+              SearchWorkspace &workspace, const BenchOptions &options, BenchCase &bench_case) {
+    Pair<double> eps = {bench_case.eps, bench_case.eps};
+    if (bench_case.algorithm == "BOAStar") {
+        BOAStar boa_star(graph, eps);
+        run_query(boa_star, source, target, heuristic, workspace, options, bench_case);
+    } else if (bench_case.algorithm == "PPA") {
+        PPA ppa(graph, eps);
+        run_query(ppa, source, target, heuristic, workspace, options, bench_case);
+    } else {
+        ParallelPPA parallel_ppa(graph, eps, nullptr, bench_case.threads);
+        run_query(parallel_ppa, source, target, heuristic, workspace, options, bench_case);
+    }
+}
+
+
+bool bench_map(const std::string &map, const BenchOptions &options, std::vector<BenchCase> &bench_cases) {
+    const std::string &resource_path = options.resource_path;
+    AdjacencyMatrix graph;
+    AdjacencyMatrix inv_graph;
+    if (load_gr_files_cached(resource_path+"USA-road-d."+map+".gr", resource_path+"USA-road-t."+map+".gr",
+                             resource_path+"USA-road-"+map+".graph", graph, inv_graph) == false) {
+        std::cerr << "Skipping " << map << ", failed to load its graph" << std::endl;
+        return false;
+    }
+
+    std::vector<std::pair<size_t, size_t>> queries;
+    if (load_queries(resource_path+"USA-road-"+map+"-queries", queries) == false) {
+        std::cerr << "Skipping " << map << ", failed to load its queries" << std::endl;
+        return false;
+    }
+
+    // Landmark tables and hierarchies of a reordered graph are saved under the name of the order
+    std::string preprocessing_name = resource_path+"USA-road-"+map;
+    if (options.order != "none") {
+        VertexOrder order;
+        if (options.order == "bfs") {
+            order = VertexOrder::breadth_first(graph, inv_graph);
+        } else {
+            std::vector<std::pair<size_t, Pair<int64_t>>> coordinates;
+            if (load_co_file(resource_path+"USA-road-d."+map+".co", coordinates) == false) {
+                std::cerr << "Skipping " << map << ", failed to load its coordinates" << std::endl;
+                return false;
+            }
+            order = VertexOrder::hilbert(graph.size(), coordinates);
+        }
+        order.reorder(graph, graph, inv_graph);
+        for (auto query = queries.begin(); query != queries.end(); ++query) {
+            *query = {order.to_internal(query->first), order.to_internal(query->second)};
+        }
+        preprocessing_name += "."+options.order;
+    }
+    if ((options.max_queries != 0) && (queries.size() > options.max_queries)) {
+        queries.resize(options.max_queries);
+    }
+
+    bool use_landmarks = std::find(options.heuristics.begin(), options.heuristics.end(), "Landmark") != options.heuristics.end();
+    bool use_shortest_path = std::find(options.heuristics.begin(), options.heuristics.end(), "ShortestPath") != options.heuristics.end();
+    bool use_lazy = std::find(options.heuristics.begin(), options.heuristics.end(), "Lazy") != options.heuristics.end();
+    bool use_hierarchy = std::find(options.heuristics.begin(), options.heuristics.end(), "Hierarchy") != options.heuristics.end();
+    LandmarkTable landmarks;
+    double landmarks_seconds = 0;
+    if (use_landmarks) {
+        TimePoint start_time = Clock::now();
+        if (load_landmarks_cached(preprocessing_name+".landmarks", graph, inv_graph, options.landmarks,
+                                  landmarks) == false) {
+            std::cerr << "Failed to save the landmarks of " << map << ", continuing with the built table" << std::endl;
+        }
+        landmarks_seconds = std::chrono::duration<double>(Clock::now() - start_time).count();
+    }
+    ContractionHierarchy hierarchy;
+    double hierarchy_seconds = 0;
+    if (use_hierarchy) {
+        TimePoint start_time = Clock::now();
+        if (load_hierarchy_cached(preprocessing_name+".hierarchy", graph, inv_graph, hierarchy) == false) {
+            std::cerr << "Failed to save the hierarchy of " << map << ", continuing with the built one" << std::endl;
+        }
+        hierarchy_seconds = std::chrono::duration<double>(Clock::now() - start_time).count();
+    }
+
+    size_t first_case = bench_cases.size();
+    for (auto heuristic = options.heuristics.begin(); heuristic != options.heuristics.end(); ++heuristic) {
+        for (auto algorithm = options.algorithms.begin(); algorithm != options.algorithms.end(); ++algorithm) {
+            if ((*algorithm == "ParallelPPA") && (*heuristic == "Lazy")) {
+                continue;
+            }
+            for (auto eps = options.eps_list.begin(); eps != options.eps_list.end(); ++eps) {
+                BenchCase bench_case;
+                bench_case.map = map;
+                bench_case.algorithm = *algorithm;
+                bench_case.eps = *eps;
+                bench_case.heuristic = *heuristic;
+                if (*heuristic == "Landmark") {
+                    bench_case.preprocessing_seconds = landmarks_seconds;
+                    bench_case.preprocessing_bytes = (landmarks.get_landmarks_amount() +
+                                                      (graph.size()+1)*4*landmarks.get_landmarks_amount())*sizeof(uint32_t);
+                } else if (*heuristic == "Hierarchy") {
+                    bench_case.preprocessing_seconds = hierarchy_seconds;
+                    bench_case.preprocessing_bytes = hierarchy.memory_bytes();
+                }
+                if (*algorithm != "ParallelPPA") {
+                    bench_cases.push_back(bench_case);
+                    continue;
+                }
+                for (auto threads = options.threads_list.begin(); threads != options.threads_list.end(); ++threads) {
+                    bench_case.threads = *threads;
+                    bench_cases.push_back(bench_case);
+                }
+            }
+        }
+    }
+
+    // All the searches share one workspace, as the batch engine workers do
+    SearchWorkspace workspace;
+    for (auto query = queries.begin(); query != queries.end(); ++query) {
+        if (use_shortest_path) {
+            ShortestPathHeuristic heuristic(query->second, graph.size(), inv_graph);
+            for (size_t case_idx = first_case; case_idx < bench_cases.size(); case_idx++) {
+                if (bench_cases[case_idx].heuristic == "ShortestPath") {
+                    run_case(graph, query->first, query->second, heuristic, workspace, options, bench_cases[case_idx]);
+                }
+            }
+        }
+        if (use_lazy) {
+            LazyShortestPathHeuristic heuristic(query->first, query->second, graph.size(), inv_graph);
+            for (size_t case_idx = first_case; case_idx < bench_cases.size(); case_idx++) {
+                if (bench_cases[case_idx].heuristic == "Lazy") {
+                    run_case(graph, query->first, query->second, heuristic, workspace, options, bench_cases[case_idx]);
+                }
+            }
+        }
+        if (use_landmarks) {
+            LandmarkHeuristic heuristic(landmarks, query->second);
+            for (size_t case_idx = first_case; case_idx < bench_cases.size(); case_idx++) {
+                if (bench_cases[case_idx].heuristic == "Landmark") {
+                    run_case(graph, query->first, query->second, heuristic, workspace, options, bench_cases[case_idx]);
+                }
+            }
+        }
+        if (use_hierarchy) {
+            HierarchyQuery heuristic(hierarchy, query->first, query->second);
+            for (size_t case_idx = first_case; case_idx < bench_cases.size(); case_idx++) {
+                if (bench_cases[case_idx].heuristic == "Hierarchy") {
+                    run_case(heuristic.get_graph(), heuristic.get_source(), heuristic.get_target(), heuristic,
+                             workspace, options, bench_cases[case_idx]);
+                }
+            }
+        }
+    }
+    return true;
+}
+
+
+void write_results(const BenchOptions &options, const std::vector<BenchCase> &bench_cases, std::ostream &stream) {
+    std::time_t now = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+    char date[32];
+    std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+
+    stream.precision(12);
+    stream << "{\n"
+           << "\t\"context\": {"
+           <<      "\"date\": \"" << date << "\", "
+           <<      "\"num_cpus\": " << std::thread::hardware_concurrency() << ", "
+           <<      "\"compiler\": \"" << __VERSION__ << "\", "
+           <<      "\"warmup\": " << options.warmup << ", "
+           <<      "\"repetitions\": " << options.repetitions << ", "
+           <<      "\"order\": \"" << options.order << "\""
+           << "},\n"
+           << "\t\"benchmarks\": [";
+
+    for (auto bench_case = bench_cases.begin(); bench_case != bench_cases.end(); ++bench_case) {
+        size_t queries = bench_case->latencies_ms.size();
+        double total_memory = 0;
+        size_t max_memory = 0;
+        for (auto memory = bench_case->memory_bytes.begin(); memory != bench_case->memory_bytes.end(); ++memory) {
+            total_memory += *memory;
+            max_memory = std::max(max_memory, *memory);
+        }
+
+        std::stringstream name;
+        name << bench_case->map << "/" << bench_case->algorithm << "/eps:" << bench_case->eps;
+        if (bench_case->algorithm == "ParallelPPA") {
+            name << "/threads:" << bench_case->threads;
+        }
+        if (bench_case->heuristic != "ShortestPath") {
+            name << "/h:" << bench_case->heuristic;
+        }
+
+        stream << ((bench_case == bench_cases.begin()) ? "\n" : ",\n")
+               << "\t\t{"
+               <<      "\"name\": \"" << name.str() << "\", "
+               <<      "\"map\": \"" << bench_case->map << "\", "
+               <<      "\"algorithm\": \"" << bench_case->algorithm << "\", "
+               <<      "\"eps\": " << bench_case->eps << ", "
+               <<      "\"threads\": " << bench_case->threads << ", "
+               <<      "\"heuristic\": \"" << bench_case->heuristic << "\", "
+               <<      "\"queries\": " << queries << ", "
+               <<      "\"median_ms\": " << percentile(bench_case->latencies_ms, 0.5) << ", "
+               <<      "\"p95_ms\": " << percentile(bench_case->latencies_ms, 0.95) << ", "
+               <<      "\"first_solution_median_ms\": " << percentile(bench_case->first_solution_ms, 0.5) << ", "
+               <<      "\"mean_ms\": " << ((queries != 0) ? 1000*bench_case->search_seconds/queries : 0) << ", "
+               <<      "\"heuristic_mean_ms\": " << ((queries != 0) ? 1000*bench_case->heuristic_seconds/queries : 0) << ", "
+               <<      "\"total_ms\": " << 1000*(bench_case->search_seconds + bench_case->heuristic_seconds) << ", "
+               <<      "\"preprocessing_ms\": " << 1000*bench_case->preprocessing_seconds << ", "
+               <<      "\"preprocessing_bytes\": " << bench_case->preprocessing_bytes << ", "
+               <<      "\"nodes_expanded\": " << bench_case->nodes_expanded << ", "
+               <<      "\"nodes_expanded_per_sec\": "
+               <<          ((bench_case->search_seconds > 0) ? bench_case->nodes_expanded/bench_case->search_seconds : 0) << ", "
+               <<      "\"avg_memory_bytes\": " << ((queries != 0) ? total_memory/queries : 0) << ", "
+               <<      "\"max_memory_bytes\": " << max_memory << ", "
+               <<      "\"solutions\": " << bench_case->solutions
+               << "}";
+    }
+    stream << "\n\t]\n}\n";
+}
+
+
+int main(int argc, char **argv) {
+    BenchOptions options;
+    if (parse_options(argc, argv, options) == false) {
+        std::cerr << "Usage: bench [--resources DIR] [--maps BAY,COL,NE,NY] [--algorithms BOAStar,PPA,ParallelPPA] "
+                  << "[--eps 0,0.01,0.05] [--threads 1,2,4] "
+                  << "[--heuristics ShortestPath,Landmark,Lazy,Hierarchy] [--landmarks N] [--order none|bfs|hilbert] [--warmup N] [--repetitions N] [--queries N] [--output FILE]" << std::endl;
+        return 1;
+    }
+
+    std::vector<BenchCase> bench_cases;
+    for (auto map = options.maps.begin(); map != options.maps.end(); ++map) {
+        std::cout << "Benchmarking " << *map << std::endl;
+        size_t first_case = bench_cases.size();
+        bench_map(*map, options, bench_cases);
+
+        for (size_t case_idx = first_case; case_idx < bench_cases.size(); case_idx++) {
+            const BenchCase &bench_case = bench_cases[case_idx];
+            std::cout << "\t" << bench_case.algorithm << " eps=" << bench_case.eps
+                      << " threads=" << bench_case.threads << " heuristic=" << bench_case.heuristic
+                      << " median=" << percentile(bench_case.latencies_ms, 0.5) << "ms"
+                      << " p95=" << percentile(bench_case.latencies_ms, 0.95) << "ms"
+                      << " heuristic_total=" << 1000*bench_case.heuristic_seconds << "ms"
+                      << " total=" << 1000*(bench_case.search_seconds + bench_case.heuristic_seconds) << "ms"
+                      << " queries=" << bench_case.latencies_ms.size() << std::endl;
+        }
+    }
+
+    std::ofstream output(options.output.c_str());
+    if (output.is_open() == false) {
+        std::cerr << "Failed to open " << options.output << std::endl;
+        return 1;
+    }
+    write_results(options, bench_cases, output);
+    std::cout << "Results written to " << options.output << std::endl;
+    return bench_cases.empty() ? 1 : 0;
+}
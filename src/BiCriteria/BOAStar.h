@@ -2,21 +2,183 @@
 #define BI_CRITERIA_BOA_STAR_H
 
 #include <vector>
+#include <algorithm>
 #include "../Utils/Definitions.h"
 #include "../Utils/Logger.h"
+#include "../Utils/OpenList.h"
+#include "../Utils/SearchWorkspace.h"
+#include "../Utils/SearchControl.h"
+#include "../Utils/SearchStats.h"
 
 class BOAStar {
 private:
     const AdjacencyMatrix   &adj_matrix;
     Pair<double>            eps;
     const LoggerPtr         logger;
+    OpenListType            open_list_type;
+    SearchWorkspace         own_workspace;
+    SearchWorkspace         *workspace;
+    const SearchControl     *control = nullptr;
+    SearchStats             stats;
+
+    template<typename OpenList, typename HeuristicT>
+    void search(size_t source, size_t target, HeuristicT &heuristic, SolutionSet &solutions,
+                SearchWorkspace &workspace, StatsClock::time_point search_start);
 
     void start_logging(size_t source, size_t target);
     void end_logging(SolutionSet &solutions);
 
 public:
-    BOAStar(const AdjacencyMatrix &adj_matrix, Pair<double> eps, const LoggerPtr logger=nullptr);
+    // OpenListType::RADIX_HEAP is faster with a consistent heuristic and also correct with an admissible
+    // one, whose nodes with f smaller than the last popped f go to a binary heap.
+    BOAStar(const AdjacencyMatrix &adj_matrix, Pair<double> eps, const LoggerPtr logger=nullptr,
+            OpenListType open_list_type=OpenListType::BINARY_HEAP);
+    // Solutions point into the node pool of the workspace and remain valid until its next search.
+    // Without a workspace argument the search uses a workspace of its own.
+    // The heuristic can be any functor taking a vertex id and returning Pair<size_t>, its calls are
+    // inlined into the search. The Heuristic overloads are the type erased convenience versions.
+    template<typename HeuristicT>
+    void operator()(size_t source, size_t target, HeuristicT &heuristic, SolutionSet &solutions);
+    template<typename HeuristicT>
+    void operator()(size_t source, size_t target, HeuristicT &heuristic, SolutionSet &solutions,
+                    SearchWorkspace &workspace);
     void operator()(size_t source, size_t target, Heuristic &heuristic, SolutionSet &solutions);
+    void operator()(size_t source, size_t target, Heuristic &heuristic, SolutionSet &solutions,
+                    SearchWorkspace &workspace);
+    // Solution callback and limits of the following searches, nullptr to run them to completion.
+    // The control must outlive the searches.
+    void set_control(const SearchControl *control);
+    // Node pool of the last search
+    const NodePool &get_nodes() const;
+    // Stats of the last search
+    const SearchStats &get_stats() const;
 };
 
+
+template<typename HeuristicT>
+void BOAStar::operator()(size_t source, size_t target, HeuristicT &heuristic, SolutionSet &solutions) {
+    (*this)(source, target, heuristic, solutions, this->own_workspace);
+}
+
+template<typename HeuristicT>
+void BOAStar::operator()(size_t source, size_t target, HeuristicT &heuristic, SolutionSet &solutions,
+                         SearchWorkspace &workspace) {
+    this->start_logging(source, target);
+
+    this->workspace = &workspace;
+    workspace.reset(this->adj_matrix.size());
+    this->stats = SearchStats();
+    this->stats.heuristic_ns = heuristic_compute_time_ns(heuristic, 0);
+
+    // Solutions are the target nodes themselves, so BOAStar has no reconstruction phase
+    StatsClock::time_point search_start = StatsClock::now();
+    size_t open_entry_bytes;
+    if (this->open_list_type == OpenListType::RADIX_HEAP) {
+        this->search<RadixHeapOpenList>(source, target, heuristic, solutions, workspace, search_start);
+        open_entry_bytes = RadixHeapOpenList::entry_bytes();
+    } else {
+        this->search<BinaryHeapOpenList>(source, target, heuristic, solutions, workspace, search_start);
+        open_entry_bytes = BinaryHeapOpenList::entry_bytes();
+    }
+    this->stats.search_ns = SearchStats::elapsed_ns(search_start);
+    this->stats.peak_memory_bytes = workspace.nodes.size()*sizeof(Node) + this->stats.peak_open_size*open_entry_bytes;
+
+    this->end_logging(solutions);
+}
+
+template<typename OpenList, typename HeuristicT>
+void BOAStar::search(size_t source, size_t target, HeuristicT &heuristic, SolutionSet &solutions,
+                     SearchWorkspace &workspace, StatsClock::time_point search_start) {
+    NodePtr node;
+    NodePtr next;
+
+    NodePool &nodes = workspace.nodes;
+    GenerationArray<size_t> &min_g2 = workspace.min_g2;
+    // Counted on a local copy which the compiler can keep in registers
+    SearchStats stats = this->stats;
+
+    // Init open list
+    OpenList open;
+    // Relaxed by an adaptive SearchControl
+    Pair<double> eps = this->eps;
+
+    node = nodes.create(source, Pair<size_t>({0,0}), heuristic(source));
+    open.insert(node);
+    stats.nodes_generated++;
+    stats.heap_pushes++;
+    stats.peak_open_size = 1;
+
+    while (open.empty() == false) {
+        if (this->control != nullptr) {
+            if ((stats.status = this->control->check_limits(stats)) != SearchStatus::COMPLETE) {
+                break;
+            }
+            if ((stats.heap_pops % SearchControl::CLOCK_CHECK_INTERVAL == 0) &&
+                this->control->exceeds_relaxation_budget(stats.eps_relaxations, stats,
+                                                         nodes.size()*sizeof(Node) + open.size()*OpenList::entry_bytes(),
+                                                         search_start)) {
+                eps = relax_eps(eps, this->control->relaxed_eps[stats.eps_relaxations++]);
+            }
+        }
+
+        // Pop min from queue and process
+        node = open.pop();
+        stats.heap_pops++;
+
+        // Dominance check
+        if (((1+eps[1])*node->f[1]) >= min_g2.get(target)) {
+            stats.pruned_by_target++;
+            continue;
+        }
+        if (node->g[1] >= min_g2.get(node->id)) {
+            stats.pruned_by_vertex++;
+            continue;
+        }
+
+        min_g2.set(node->id, node->g[1]);
+
+        // Target nodes are popped in order of their first cost, so every solution is final once popped
+        if (node->id == target) {
+            solutions.push_back(node);
+            if (deliver_solution(this->control, *node, nodes, search_start, stats) == false) {
+                break;
+            }
+            continue;
+        }
+        stats.nodes_expanded++;
+
+        // Check to which neighbors we should extend the paths
+        const AdjacencyMatrix::OutgoingEdges outgoing_edges = adj_matrix[node->id];
+        for (size_t edge_idx = 0; edge_idx < outgoing_edges.size; edge_idx++) {
+            size_t next_id = outgoing_edges.target[edge_idx];
+            Pair<size_t> next_g = {size_t(node->g[0])+outgoing_edges.cost[0][edge_idx],
+                                   size_t(node->g[1])+outgoing_edges.cost[1][edge_idx]};
+            Pair<size_t> next_h = heuristic(next_id);
+
+            // Dominance check
+            if (((1+eps[1])*(next_g[1]+next_h[1])) >= min_g2.get(target)) {
+                stats.pruned_by_target++;
+                continue;
+            }
+            if (next_g[1] >= min_g2.get(next_id)) {
+                stats.pruned_by_vertex++;
+                continue;
+            }
+
+            // If not dominated create node and push to queue
+            // Creation is defered after dominance check as it is
+            // relatively computational heavy and should be avoided if possible
+            next = nodes.create(next_id, next_g, next_h, node->handle);
+
+            open.insert(next);
+            stats.nodes_generated++;
+            stats.heap_pushes++;
+            stats.peak_open_size = std::max(stats.peak_open_size, open.size());
+        }
+    }
+
+    stats.achieved_eps = std::max(eps[0], eps[1]);
+    this->stats = stats;
+}
+
 #endif //BI_CRITERIA_BOA_STAR_H
\ No newline at end of file
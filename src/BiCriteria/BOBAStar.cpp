@@ -0,0 +1,72 @@
+#include <memory>
+#include <sstream>
+
+#include "BOBAStar.h"
+
+BOBAStar::BOBAStar(const AdjacencyMatrix &graph, const AdjacencyMatrix &inv_graph, const LoggerPtr logger,
+                   bool concurrent, OpenListType open_list_type) :
+    graph(graph), inv_graph(inv_graph), logger(logger), concurrent(concurrent), open_list_type(open_list_type) {}
+
+
+void BOBAStar::operator()(size_t source, size_t target, Heuristic &forward_heuristic, Heuristic &backward_heuristic,
+                          SolutionSet &solutions) {
+    this->operator()<Heuristic, Heuristic>(source, target, forward_heuristic, backward_heuristic, solutions);
+}
+
+
+const NodePool &BOBAStar::get_nodes() const {
+    return this->forward_workspace.nodes;
+}
+
+
+const SearchStats &BOBAStar::get_stats() const {
+    return this->stats;
+}
+
+
+void BOBAStar::start_logging(size_t source, size_t target) {
+    if (this->logger == nullptr) {
+        return;
+    }
+
+    // All logging is done in JSON format
+    std::stringstream start_info_json;
+    start_info_json
+        << "{"
+        <<      "\"name\": \"BOBAStar\", "
+        <<      "\"eps\": " << Pair<double>({0, 0}) << ", "
+        <<      "\"concurrent\": " << (this->concurrent ? "true" : "false")
+        << "}";
+
+    LOG_START_SEARCH(*this->logger, source, target, start_info_json.str());
+}
+
+
+void BOBAStar::end_logging(SolutionSet &solutions) {
+    if (this->logger == nullptr) {
+        return;
+    }
+
+    // All logging is done in JSON format
+    std::stringstream finish_info_json;
+    finish_info_json
+        << "{"
+        <<      "\"solutions\": [";
+
+    size_t solutions_count = 0;
+    for (auto solution = solutions.begin(); solution != solutions.end(); ++solution) {
+        if (solution != solutions.begin()) {
+            finish_info_json << ", ";
+        }
+        finish_info_json << PooledNode{**solution, this->forward_workspace.nodes};
+        solutions_count++;
+    }
+
+    finish_info_json
+        <<      "], "
+        <<      "\"amount_of_solutions\": " << solutions_count << ", "
+        <<      "\"stats\": " << this->stats
+        << "}";
+
+    LOG_FINISH_SEARCH(*(this->logger), finish_info_json.str());
+}
@@ -0,0 +1,286 @@
+#ifndef BI_CRITERIA_BOBA_STAR_H
+#define BI_CRITERIA_BOBA_STAR_H
+
+#include <vector>
+#include <atomic>
+#include <thread>
+#include <algorithm>
+#include "../Utils/Definitions.h"
+#include "../Utils/Logger.h"
+#include "../Utils/OpenList.h"
+#include "../Utils/SearchWorkspace.h"
+#include "../Utils/SearchStats.h"
+
+
+// Reads dominant_path_next() of the heuristics that provide it, see Definitions.h
+template<typename HeuristicT>
+auto heuristic_dominant_path_next(const HeuristicT &heuristic, size_t cost_idx, size_t node_id, int)
+        -> decltype(size_t(heuristic.dominant_path_next(cost_idx, node_id))) {
+    return heuristic.dominant_path_next(cost_idx, node_id);
+}
+
+template<typename HeuristicT>
+size_t heuristic_dominant_path_next(const HeuristicT &, size_t, size_t, long) {
+    return NO_PATH;
+}
+
+
+// One direction of BOBAStar, a BOA* search whose nodes keep their costs ordered by the objective
+// the direction minimizes first: (c1, c2) for the forward search and (c2, c1) for the backward one.
+// Every solution found publishes its secondary cost as a bound. The other direction prunes nodes whose
+// primary f reaches that bound, as all the pareto solutions from there on were found already.
+// A node whose heuristic path to the goal is shortest for both costs is a solution with cost f, as
+// nothing else reachable from it is pareto optimal (early solution detection).
+template<typename OpenList, typename HeuristicT>
+class BOBAStarDirection {
+private:
+    const AdjacencyMatrix       &graph;
+    size_t                      goal;
+    size_t                      primary;
+    HeuristicT                  &heuristic;
+    SearchWorkspace             &workspace;
+    std::atomic<size_t>         &own_bound;
+    const std::atomic<size_t>   &other_bound;
+    OpenList                    open;
+
+    Pair<size_t> ordered(const Pair<size_t> &costs) const {
+        return (this->primary == 0) ? costs : Pair<size_t>({costs[1], costs[0]});
+    }
+
+    bool is_bounded(size_t f1, size_t f2) {
+        if ((f1 >= this->other_bound.load(std::memory_order_relaxed)) ||
+            (f2 >= this->workspace.min_g2.get(this->goal))) {
+            this->stats.pruned_by_target++;
+            return true;
+        }
+        return false;
+    }
+
+public:
+    SolutionSet                 solutions;
+    SearchStats                 stats;
+
+    BOBAStarDirection(const AdjacencyMatrix &graph, size_t start, size_t goal, size_t primary, HeuristicT &heuristic,
+                      SearchWorkspace &workspace, std::atomic<size_t> &own_bound, const std::atomic<size_t> &other_bound)
+        : graph(graph), goal(goal), primary(primary), heuristic(heuristic), workspace(workspace),
+          own_bound(own_bound), other_bound(other_bound) {
+        workspace.reset(graph.size());
+        this->open.insert(workspace.nodes.create(start, Pair<size_t>({0,0}), this->ordered(heuristic(start))));
+        this->stats.nodes_generated = 1;
+        this->stats.heap_pushes = 1;
+        this->stats.peak_open_size = 1;
+    }
+
+    // Pops a single node and expands it if it is not dominated. Returns false once the open list is empty.
+    bool step(void) {
+        if (this->open.empty()) {
+            return false;
+        }
+
+        NodePtr node = this->open.pop();
+        this->stats.heap_pops++;
+
+        // Dominance check
+        if (this->is_bounded(node->f[0], node->f[1])) {
+            return true;
+        }
+        if (node->g[1] >= this->workspace.min_g2.get(node->id)) {
+            this->stats.pruned_by_vertex++;
+            return true;
+        }
+        this->workspace.min_g2.set(node->id, node->g[1]);
+
+        if ((node->id == this->goal) ||
+            (heuristic_dominant_path_next(this->heuristic, this->primary, node->id, 0) != NO_PATH)) {
+            this->solutions.push_back(node);
+            this->workspace.min_g2.set(this->goal, node->f[1]);
+            this->own_bound.store(node->f[1], std::memory_order_relaxed);
+            return true;
+        }
+        this->stats.nodes_expanded++;
+
+        const AdjacencyMatrix::OutgoingEdges outgoing_edges = this->graph[node->id];
+        for (size_t edge_idx = 0; edge_idx < outgoing_edges.size; edge_idx++) {
+            size_t next_id = outgoing_edges.target[edge_idx];
+            Pair<size_t> next_g = {size_t(node->g[0])+outgoing_edges.cost[this->primary][edge_idx],
+                                   size_t(node->g[1])+outgoing_edges.cost[1-this->primary][edge_idx]};
+            Pair<size_t> next_h = this->ordered(this->heuristic(next_id));
+
+            // Dominance check
+            if (this->is_bounded(next_g[0]+next_h[0], next_g[1]+next_h[1])) {
+                continue;
+            }
+            if (next_g[1] >= this->workspace.min_g2.get(next_id)) {
+                this->stats.pruned_by_vertex++;
+                continue;
+            }
+
+            this->open.insert(this->workspace.nodes.create(next_id, next_g, next_h, node->handle));
+            this->stats.nodes_generated++;
+            this->stats.heap_pushes++;
+            this->stats.peak_open_size = std::max(this->stats.peak_open_size, this->open.size());
+        }
+        return true;
+    }
+
+    void run(void) {
+        while (this->step()) {}
+    }
+};
+
+
+// Exact bidirectional bi-objective search in the spirit of BOBA*. A forward BOA* from the source
+// finds the pareto set from its c1 optimal end while a backward BOA* from the target over the
+// inverse graph finds it from its c2 optimal end, and both stop where they meet.
+// The directions either alternate on the calling thread or run concurrently on two threads.
+class BOBAStar {
+private:
+    const AdjacencyMatrix   &graph;
+    const AdjacencyMatrix   &inv_graph;
+    const LoggerPtr         logger;
+    bool                    concurrent;
+    OpenListType            open_list_type;
+    SearchWorkspace         forward_workspace;
+    SearchWorkspace         backward_workspace;
+    SearchStats             stats;
+
+    template<typename OpenList, typename ForwardHeuristicT, typename BackwardHeuristicT>
+    void search(size_t source, size_t target, ForwardHeuristicT &forward_heuristic,
+                BackwardHeuristicT &backward_heuristic, SolutionSet &solutions);
+
+    void start_logging(size_t source, size_t target);
+    void end_logging(SolutionSet &solutions);
+
+public:
+    BOBAStar(const AdjacencyMatrix &graph, const AdjacencyMatrix &inv_graph, const LoggerPtr logger=nullptr,
+             bool concurrent=false, OpenListType open_list_type=OpenListType::BINARY_HEAP);
+
+    // forward_heuristic bounds the costs from a vertex to the target, and backward_heuristic the
+    // costs from the source to a vertex (i.e. shortest paths over the graph from the source).
+    // Heuristics providing dominant_path_next() enable early solution detection.
+    // Solutions are ordered by increasing c1 and remain valid until the next search.
+    template<typename ForwardHeuristicT, typename BackwardHeuristicT>
+    void operator()(size_t source, size_t target, ForwardHeuristicT &forward_heuristic,
+                    BackwardHeuristicT &backward_heuristic, SolutionSet &solutions);
+    void operator()(size_t source, size_t target, Heuristic &forward_heuristic, Heuristic &backward_heuristic,
+                    SolutionSet &solutions);
+
+    // Node pool of the solutions of the last search
+    const NodePool &get_nodes() const;
+    // Stats of the last search, summed over both directions
+    const SearchStats &get_stats() const;
+};
+
+
+template<typename ForwardHeuristicT, typename BackwardHeuristicT>
+void BOBAStar::operator()(size_t source, size_t target, ForwardHeuristicT &forward_heuristic,
+                          BackwardHeuristicT &backward_heuristic, SolutionSet &solutions) {
+    this->start_logging(source, target);
+
+    this->stats = SearchStats();
+    this->stats.heuristic_ns = heuristic_compute_time_ns(forward_heuristic, 0) +
+                               heuristic_compute_time_ns(backward_heuristic, 0);
+
+    if (this->open_list_type == OpenListType::RADIX_HEAP) {
+        this->search<RadixHeapOpenList>(source, target, forward_heuristic, backward_heuristic, solutions);
+    } else {
+        this->search<BinaryHeapOpenList>(source, target, forward_heuristic, backward_heuristic, solutions);
+    }
+
+    this->end_logging(solutions);
+}
+
+
+template<typename OpenList, typename ForwardHeuristicT, typename BackwardHeuristicT>
+void BOBAStar::search(size_t source, size_t target, ForwardHeuristicT &forward_heuristic,
+                      BackwardHeuristicT &backward_heuristic, SolutionSet &solutions) {
+    StatsClock::time_point search_start = StatsClock::now();
+
+    // Secondary cost of the last solution of each direction: c2 for the forward one, c1 for the backward one
+    std::atomic<size_t> forward_bound(MAX_COST);
+    std::atomic<size_t> backward_bound(MAX_COST);
+
+    BOBAStarDirection<OpenList, ForwardHeuristicT> forward(
+        this->graph, source, target, 0, forward_heuristic, this->forward_workspace, forward_bound, backward_bound);
+    BOBAStarDirection<OpenList, BackwardHeuristicT> backward(
+        this->inv_graph, target, source, 1, backward_heuristic, this->backward_workspace, backward_bound, forward_bound);
+
+    if (this->concurrent) {
+        std::thread backward_thread(&BOBAStarDirection<OpenList, BackwardHeuristicT>::run, &backward);
+        forward.run();
+        backward_thread.join();
+    } else {
+        bool forward_open = true;
+        bool backward_open = true;
+        while (forward_open || backward_open) {
+            forward_open = forward_open && forward.step();
+            backward_open = backward_open && backward.step();
+        }
+    }
+    this->stats.search_ns = SearchStats::elapsed_ns(search_start);
+
+    // Solutions detected early are completed by the heuristic paths. Backward solutions are rebuilt as
+    // forward paths in the forward node pool, their costs from the source are the total cost minus the
+    // cost to the target that the backward nodes hold.
+    StatsClock::time_point reconstruction_start = StatsClock::now();
+    NodePool &nodes = this->forward_workspace.nodes;
+    const NodePool &backward_nodes = this->backward_workspace.nodes;
+    for (auto solution = forward.solutions.begin(); solution != forward.solutions.end(); ++solution) {
+        Pair<size_t> total = {(*solution)->f[0], (*solution)->f[1]};
+        NodePtr forward_node = *solution;
+        while (forward_node->id != target) {
+            size_t next_id = heuristic_dominant_path_next(forward_heuristic, 0, forward_node->id, 0);
+            Pair<size_t> h = forward_heuristic(next_id);
+            forward_node = nodes.create(next_id, Pair<size_t>({total[0]-h[0], total[1]-h[1]}), h, forward_node->handle);
+        }
+        solutions.push_back(forward_node);
+    }
+    std::vector<size_t> path_to_source;
+    for (auto solution = backward.solutions.rbegin(); solution != backward.solutions.rend(); ++solution) {
+        Pair<size_t> total = {(*solution)->f[1], (*solution)->f[0]};
+        // Both lists hold pareto solutions ordered by c1, so one not beyond the last c1 was found by both
+        // directions. This happens where they meet, and over a longer stretch when they run concurrently.
+        if ((solutions.empty() == false) && (total[0] <= solutions.back()->g[0])) {
+            continue;
+        }
+
+        // Heuristic path between the source and the vertex the solution was detected at, its costs are exact
+        path_to_source.clear();
+        for (size_t vertex = (*solution)->id; vertex != source; ) {
+            vertex = heuristic_dominant_path_next(backward_heuristic, 1, vertex, 0);
+            path_to_source.push_back(vertex);
+        }
+        NodeHandle parent = NULL_HANDLE;
+        for (auto vertex = path_to_source.rbegin(); vertex != path_to_source.rend(); ++vertex) {
+            parent = nodes.create(*vertex, backward_heuristic(*vertex), forward_heuristic(*vertex), parent)->handle;
+        }
+
+        NodePtr forward_node = nullptr;
+        for (const Node *node = *solution; ; node = &backward_nodes[node->parent]) {
+            Pair<size_t> g = {total[0]-node->g[1], total[1]-node->g[0]};
+            forward_node = nodes.create(node->id, g, forward_heuristic(node->id), parent);
+            parent = forward_node->handle;
+            if (node->parent == NULL_HANDLE) {
+                break;
+            }
+        }
+        solutions.push_back(forward_node);
+    }
+    this->stats.reconstruction_ns = SearchStats::elapsed_ns(reconstruction_start);
+
+    const SearchStats *direction_stats[] = {&forward.stats, &backward.stats};
+    for (size_t i = 0; i < 2; i++) {
+        const SearchStats *direction = direction_stats[i];
+        this->stats.nodes_generated += direction->nodes_generated;
+        this->stats.nodes_expanded += direction->nodes_expanded;
+        this->stats.pruned_by_target += direction->pruned_by_target;
+        this->stats.pruned_by_vertex += direction->pruned_by_vertex;
+        this->stats.heap_pushes += direction->heap_pushes;
+        this->stats.heap_pops += direction->heap_pops;
+        this->stats.peak_open_size += direction->peak_open_size;
+        this->stats.peak_memory_bytes += direction->peak_open_size*OpenList::entry_bytes();
+    }
+    this->stats.peak_memory_bytes += (this->forward_workspace.nodes.size() + this->backward_workspace.nodes.size())*sizeof(Node);
+}
+
+#endif //BI_CRITERIA_BOBA_STAR_H
@@ -4,23 +4,170 @@
 #include "../Utils/Definitions.h"
 #include "../Utils/Logger.h"
 #include "../Utils/PPQueue.h"
+#include "../Utils/SearchWorkspace.h"
+#include "../Utils/SearchControl.h"
+#include "../Utils/SearchStats.h"
 
 
 class PPA {
 private:
     const AdjacencyMatrix   &adj_matrix;
     Pair<double>            eps;
+    // Eps of the current search, relaxed by an adaptive SearchControl
+    Pair<double>            search_eps;
     const LoggerPtr         logger;
+    SearchWorkspace         own_workspace;
+    SearchWorkspace         *workspace;
+    const SearchControl     *control = nullptr;
+    // Solutions of the current search passed to the solution callback so far
+    size_t                  delivered_solutions;
+    SearchStats             stats;
 
     void start_logging(size_t source, size_t target);
-    void end_logging(SolutionSet &solutions);
+    void end_logging(PPSolutionSet &pp_solutions);
 
     void insert(PathPairPtr &pp, PPQueue &queue);
     void merge_to_solutions(const PathPairPtr &pp, PPSolutionSet &solutions);
+    void finish_search(PPSolutionSet &pp_solutions, SolutionSet &solutions, const PPQueue &open);
+    // Delivers the solutions whose top left cost is below min_f1, returns false if the search should stop
+    bool deliver_solutions(const PPSolutionSet &pp_solutions, size_t min_f1, StatsClock::time_point search_start);
 
 public:
     PPA(const AdjacencyMatrix &adj_matrix, Pair<double> eps, const LoggerPtr logger=nullptr);
+    // Solutions point into the node pool of the workspace and remain valid until its next search.
+    // Without a workspace argument the search uses a workspace of its own.
+    // The heuristic can be any functor taking a vertex id and returning Pair<size_t>, its calls are
+    // inlined into the search. The Heuristic overloads are the type erased convenience versions.
+    template<typename HeuristicT>
+    void operator()(size_t source, size_t target, HeuristicT &heuristic, SolutionSet &solutions);
+    template<typename HeuristicT>
+    void operator()(size_t source, size_t target, HeuristicT &heuristic, SolutionSet &solutions,
+                    SearchWorkspace &workspace);
     void operator()(size_t source, size_t target, Heuristic &heuristic, SolutionSet &solutions);
+    void operator()(size_t source, size_t target, Heuristic &heuristic, SolutionSet &solutions,
+                    SearchWorkspace &workspace);
+    // Solution callback and limits of the following searches, nullptr to run them to completion.
+    // The control must outlive the searches.
+    void set_control(const SearchControl *control);
+    // Node pool of the last search
+    const NodePool &get_nodes() const;
+    // Stats of the last search
+    const SearchStats &get_stats() const;
 };
 
+
+template<typename HeuristicT>
+void PPA::operator()(size_t source, size_t target, HeuristicT &heuristic, SolutionSet &solutions) {
+    (*this)(source, target, heuristic, solutions, this->own_workspace);
+}
+
+
+template<typename HeuristicT>
+void PPA::operator()(size_t source, size_t target, HeuristicT &heuristic, SolutionSet &solutions,
+                     SearchWorkspace &workspace) {
+    this->start_logging(source, target);
+
+    PPSolutionSet pp_solutions;
+    PathPairPtr   pp;
+    PathPairPtr   next_pp;
+
+    this->workspace = &workspace;
+    workspace.reset(this->adj_matrix.size());
+    this->stats = SearchStats();
+    this->stats.heuristic_ns = heuristic_compute_time_ns(heuristic, 0);
+    this->delivered_solutions = 0;
+    this->search_eps = this->eps;
+    StatsClock::time_point search_start = StatsClock::now();
+
+    NodePool &nodes = workspace.nodes;
+    PathPairPool &path_pairs = workspace.path_pairs;
+    GenerationArray<size_t> &min_g2 = workspace.min_g2;
+    PPQueue &open = workspace.pp_queue;
+
+    NodePtr source_node = nodes.create(source, Pair<size_t>({0,0}), heuristic(source));
+    pp = path_pairs.create(source_node, source_node);
+    this->stats.nodes_generated++;
+    this->insert(pp, open);
+
+    while (open.empty() == false) {
+        if (this->control != nullptr) {
+            if ((this->stats.status = this->control->check_limits(this->stats)) != SearchStatus::COMPLETE) {
+                break;
+            }
+            if ((this->stats.heap_pops % SearchControl::CLOCK_CHECK_INTERVAL == 0) &&
+                this->control->exceeds_relaxation_budget(this->stats.eps_relaxations, this->stats,
+                                                         nodes.size()*sizeof(Node) + path_pairs.size()*sizeof(PathPair) +
+                                                         open.size()*PPQueue::entry_bytes(),
+                                                         search_start)) {
+                this->search_eps = relax_eps(this->search_eps,
+                                             this->control->relaxed_eps[this->stats.eps_relaxations++]);
+            }
+        }
+
+        // Pop min from queue and process
+        pp = open.pop();
+        this->stats.heap_pops++;
+
+        // Path pairs are popped in order of their top left f1, so a later path pair could only merge into
+        // a solution whose top left g1 is not below it. The solutions before that are final.
+        if (this->deliver_solutions(pp_solutions, pp->top_left->f[0], search_start) == false) {
+            break;
+        }
+
+        // Dominance check
+        if (((1+this->search_eps[1])*pp->bottom_right->f[1]) >= min_g2.get(target)) {
+            this->stats.pruned_by_target++;
+            continue;
+        }
+        if (pp->bottom_right->g[1] >= min_g2.get(pp->id)) {
+            this->stats.pruned_by_vertex++;
+            continue;
+        }
+        min_g2.set(pp->id, pp->bottom_right->g[1]);
+
+        if (pp->id == target) {
+            this->merge_to_solutions(pp, pp_solutions);
+            continue;
+        }
+        this->stats.nodes_expanded++;
+
+        // Check to which neighbors we should extend the paths
+        const AdjacencyMatrix::OutgoingEdges outgoing_edges = adj_matrix[pp->id];
+        for (size_t edge_idx = 0; edge_idx < outgoing_edges.size; edge_idx++) {
+            // Prepare extension of path pair
+            size_t next_id = outgoing_edges.target[edge_idx];
+            Pair<size_t> top_left_next_g = {size_t(pp->top_left->g[0])+outgoing_edges.cost[0][edge_idx],
+                                            size_t(pp->top_left->g[1])+outgoing_edges.cost[1][edge_idx]};
+            Pair<size_t> bottom_right_next_g = {size_t(pp->bottom_right->g[0])+outgoing_edges.cost[0][edge_idx],
+                                                size_t(pp->bottom_right->g[1])+outgoing_edges.cost[1][edge_idx]};
+            Pair<size_t> next_h = heuristic(next_id);
+
+            // Dominance check
+            if (((1+this->search_eps[1])*(bottom_right_next_g[1]+next_h[1])) >= min_g2.get(target)) {
+                this->stats.pruned_by_target++;
+                continue;
+            }
+            if (bottom_right_next_g[1] >= min_g2.get(next_id)) {
+                this->stats.pruned_by_vertex++;
+                continue;
+            }
+
+            // If not dominated extend path pair and push to queue
+            // Creation is defered after dominance check as it is
+            // relatively computational heavy and should be avoided if possible
+            next_pp = path_pairs.create(
+                            nodes.create(next_id, top_left_next_g, next_h, pp->top_left->handle),
+                            nodes.create(next_id, bottom_right_next_g, next_h, pp->top_left->handle));
+
+            this->stats.nodes_generated++;
+            this->insert(next_pp, open);
+        }
+    }
+    this->deliver_solutions(pp_solutions, MAX_COST, search_start);
+    this->stats.achieved_eps = std::max(this->search_eps[0], this->search_eps[1]);
+    this->stats.search_ns = SearchStats::elapsed_ns(search_start);
+
+    this->finish_search(pp_solutions, solutions, open);
+}
+
 #endif //BI_CRITERIA_PPA_H
\ No newline at end of file
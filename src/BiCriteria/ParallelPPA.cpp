@@ -0,0 +1,136 @@
+#include <memory>
+#include <algorithm>
+#include <sstream>
+#include <vector>
+
+#include "ParallelPPA.h"
+
+
+ParallelPPA::ParallelPPA(const AdjacencyMatrix &adj_matrix, Pair<double> eps, const LoggerPtr logger,
+                         size_t threads_amount, size_t batch_size) :
+    adj_matrix(adj_matrix), eps(eps), logger(logger), batch_size(std::max<size_t>(1, batch_size)),
+    team(threads_amount), workspace(&own_workspace) {}
+
+
+void ParallelPPA::insert(PathPairPtr &pp, PPQueue &queue) {
+    for (PathPairPtr existing_pp = queue.get_open_pps(pp->id); existing_pp != nullptr; existing_pp = existing_pp->next_open) {
+        if (pp->update_nodes_by_merge_if_bounded(existing_pp, this->eps) == true) {
+            // pp and existing_pp were merged successfuly into pp
+            if ((pp->top_left != existing_pp->top_left) ||
+                (pp->bottom_right != existing_pp->bottom_right)) {
+                existing_pp->top_left = pp->top_left;
+                existing_pp->bottom_right = pp->bottom_right;
+                queue.update(existing_pp);
+            }
+            this->stats.merges++;
+            return;
+        }
+    }
+    queue.insert(pp);
+    this->stats.heap_pushes++;
+    this->stats.peak_open_size = std::max(this->stats.peak_open_size, queue.size());
+}
+
+
+void ParallelPPA::merge_to_solutions(const PathPairPtr &pp, PPSolutionSet &solutions) {
+    for (auto existing_solution = solutions.begin(); existing_solution != solutions.end(); ++existing_solution) {
+        if ((*existing_solution)->update_nodes_by_merge_if_bounded(pp, this->eps) == true) {
+            return;
+        }
+    }
+    solutions.push_back(pp);
+}
+
+
+void ParallelPPA::operator()(size_t source, size_t target, Heuristic &heuristic, SolutionSet &solutions) {
+    this->operator()<Heuristic>(source, target, heuristic, solutions, this->own_workspace);
+}
+
+
+void ParallelPPA::operator()(size_t source, size_t target, Heuristic &heuristic, SolutionSet &solutions,
+                             SearchWorkspace &workspace) {
+    this->operator()<Heuristic>(source, target, heuristic, solutions, workspace);
+}
+
+
+void ParallelPPA::finish_search(PPSolutionSet &pp_solutions, SolutionSet &solutions, const PPQueue &open) {
+    StatsClock::time_point reconstruction_start = StatsClock::now();
+    for (auto solution = pp_solutions.begin(); solution != pp_solutions.end(); ++solution) {
+        solutions.push_back((*solution)->top_left);
+    }
+    this->stats.reconstruction_ns = SearchStats::elapsed_ns(reconstruction_start);
+
+    this->stats.achieved_eps = std::max(this->eps[0], this->eps[1]);
+    this->stats.tombstones_avoided = open.get_tombstones_avoided();
+    this->stats.peak_memory_bytes = this->workspace->nodes.size()*sizeof(Node) +
+                                    this->workspace->path_pairs.size()*sizeof(PathPair) +
+                                    this->stats.peak_open_size*PPQueue::entry_bytes();
+
+    this->end_logging(pp_solutions);
+}
+
+
+const NodePool &ParallelPPA::get_nodes() const {
+    return this->workspace->nodes;
+}
+
+
+const SearchStats &ParallelPPA::get_stats() const {
+    return this->stats;
+}
+
+
+size_t ParallelPPA::get_threads_amount() const {
+    return this->team.size();
+}
+
+
+void ParallelPPA::start_logging(size_t source, size_t target) {
+    if (this->logger == nullptr) {
+        return;
+    }
+
+    // All logging is done in JSON format
+    std::stringstream start_info_json;
+    start_info_json
+        << "{"
+        <<      "\"name\": \"ParallelPPA\", "
+        <<      "\"eps\": " << this->eps << ", "
+        <<      "\"threads\": " << this->team.size() << ", "
+        <<      "\"batch_size\": " << this->batch_size
+        << "}";
+
+    LOG_START_SEARCH(*this->logger, source, target, start_info_json.str());
+}
+
+
+void ParallelPPA::end_logging(PPSolutionSet &pp_solutions) {
+    if (this->logger == nullptr) {
+        return;
+    }
+
+    // All logging is done in JSON format
+    std::stringstream finish_info_json;
+    finish_info_json
+        << "{"
+        <<      "\"solutions\": [";
+
+    // Both nodes of every path pair are logged, as in PPA
+    size_t solutions_count = 0;
+    for (auto solution = pp_solutions.begin(); solution != pp_solutions.end(); ++solution) {
+        if (solution != pp_solutions.begin()) {
+            finish_info_json << ", ";
+        }
+        finish_info_json << PooledNode{*(*solution)->top_left, this->workspace->nodes} << ", "
+                         << PooledNode{*(*solution)->bottom_right, this->workspace->nodes};
+        solutions_count += 2;
+    }
+
+    finish_info_json
+        <<      "], "
+        <<      "\"amount_of_solutions\": " << solutions_count << ", "
+        <<      "\"stats\": " << this->stats
+        << "}";
+
+    LOG_FINISH_SEARCH(*(this->logger), finish_info_json.str());
+}
@@ -0,0 +1,269 @@
+#ifndef BI_CRITERIA_PARALLEL_PPA_H
+#define BI_CRITERIA_PARALLEL_PPA_H
+
+#include <vector>
+#include <unordered_map>
+#include "../Utils/Definitions.h"
+#include "../Utils/Logger.h"
+#include "../Utils/PPQueue.h"
+#include "../Utils/GenerationArray.h"
+#include "../Utils/SearchWorkspace.h"
+#include "../Utils/SearchStats.h"
+#include "../Utils/WorkerTeam.h"
+
+
+// Shared memory parallel PPA. The search is PPA itself: path pairs are popped, checked for dominance,
+// merged and inserted on the calling thread in the order of PPA. Every quarter batch of pops, a team of
+// threads computes ahead the extensions of the first batch_size path pairs of the queue, with their
+// heuristics, and marks those the current bounds already prune. The bounds only get tighter, so such a
+// mark still holds when the path pair is popped, and the other extensions are checked again then. An
+// expansion computed ahead is used only if the nodes of its path pair are unchanged when it is popped.
+// Path pairs popped before they were reached, often right after they were inserted, or changed by a
+// merge are expanded on the calling thread.
+//
+// The solutions are therefore exactly those of PPA for any batch size and amount of threads, including
+// which path pairs merge, and keep the (1+eps) bound update_nodes_by_merge_if_bounded enforces on every
+// path pair. Only the expansions computed ahead run concurrently, about half of them on road graphs,
+// so the gain is bounded well below the amount of threads. With a single thread it runs PPA.
+class ParallelPPA {
+private:
+    // Extension of a path pair, pruned marks it as bounded when it was computed
+    struct Extension {
+        size_t          id;
+        Pair<size_t>    top_left_g;
+        Pair<size_t>    bottom_right_g;
+        Pair<size_t>    h;
+        bool            pruned_by_target;
+        bool            pruned_by_vertex;
+    };
+
+    // Expansion of a path pair computed ahead, valid while the path pair holds the same nodes
+    struct Expansion {
+        PathPairPtr             pp;
+        NodePtr                 top_left;
+        NodePtr                 bottom_right;
+        std::vector<Extension>  extensions;
+    };
+
+    const AdjacencyMatrix                       &adj_matrix;
+    Pair<double>                                eps;
+    const LoggerPtr                             logger;
+    size_t                                      batch_size;
+    WorkerTeam                                  team;
+    SearchWorkspace                             own_workspace;
+    SearchWorkspace                             *workspace;
+    std::vector<PathPairPtr>                    batch;
+    std::vector<size_t>                         batch_slots;
+    // Expansions computed ahead, kept until their path pair is popped
+    std::vector<Expansion>                      expansions;
+    std::vector<size_t>                         free_slots;
+    std::unordered_map<PathPairPtr, size_t>     prefetched;
+    // Expansion of the path pair popped before it was computed ahead
+    Expansion                                   inline_expansion;
+    SearchStats                                 stats;
+
+    template<typename HeuristicT>
+    void compute_expansion(const PathPairPtr &pp, size_t target, HeuristicT &heuristic, Expansion &expansion);
+    template<typename HeuristicT>
+    void prefetch(size_t target, HeuristicT &heuristic);
+
+    void start_logging(size_t source, size_t target);
+    void end_logging(PPSolutionSet &pp_solutions);
+
+    void insert(PathPairPtr &pp, PPQueue &queue);
+    void merge_to_solutions(const PathPairPtr &pp, PPSolutionSet &solutions);
+    void finish_search(PPSolutionSet &pp_solutions, SolutionSet &solutions, const PPQueue &open);
+
+public:
+    // threads_amount=0 uses all available cores
+    ParallelPPA(const AdjacencyMatrix &adj_matrix, Pair<double> eps, const LoggerPtr logger=nullptr,
+                size_t threads_amount=0, size_t batch_size=256);
+    // Same interface as PPA, solutions point into the node pool of the workspace.
+    // The heuristic is called concurrently and must not modify shared state.
+    template<typename HeuristicT>
+    void operator()(size_t source, size_t target, HeuristicT &heuristic, SolutionSet &solutions);
+    template<typename HeuristicT>
+    void operator()(size_t source, size_t target, HeuristicT &heuristic, SolutionSet &solutions,
+                    SearchWorkspace &workspace);
+    void operator()(size_t source, size_t target, Heuristic &heuristic, SolutionSet &solutions);
+    void operator()(size_t source, size_t target, Heuristic &heuristic, SolutionSet &solutions,
+                    SearchWorkspace &workspace);
+    // Node pool of the last search
+    const NodePool &get_nodes() const;
+    // Stats of the last search
+    const SearchStats &get_stats() const;
+    size_t get_threads_amount() const;
+};
+
+
+template<typename HeuristicT>
+void ParallelPPA::operator()(size_t source, size_t target, HeuristicT &heuristic, SolutionSet &solutions) {
+    (*this)(source, target, heuristic, solutions, this->own_workspace);
+}
+
+
+template<typename HeuristicT>
+void ParallelPPA::compute_expansion(const PathPairPtr &pp, size_t target, HeuristicT &heuristic, Expansion &expansion) {
+    const GenerationArray<size_t> &min_g2 = this->workspace->min_g2;
+    expansion.pp = pp;
+    expansion.top_left = pp->top_left;
+    expansion.bottom_right = pp->bottom_right;
+    expansion.extensions.clear();
+
+    const AdjacencyMatrix::OutgoingEdges outgoing_edges = this->adj_matrix[pp->id];
+    for (size_t edge_idx = 0; edge_idx < outgoing_edges.size; edge_idx++) {
+        size_t next_id = outgoing_edges.target[edge_idx];
+        Pair<size_t> top_left_next_g = {size_t(pp->top_left->g[0])+outgoing_edges.cost[0][edge_idx],
+                                        size_t(pp->top_left->g[1])+outgoing_edges.cost[1][edge_idx]};
+        Pair<size_t> bottom_right_next_g = {size_t(pp->bottom_right->g[0])+outgoing_edges.cost[0][edge_idx],
+                                            size_t(pp->bottom_right->g[1])+outgoing_edges.cost[1][edge_idx]};
+        Pair<size_t> next_h = heuristic(next_id);
+
+        // Same checks as PPA against the bounds as they are now
+        bool pruned_by_target = ((1+this->eps[1])*(bottom_right_next_g[1]+next_h[1])) >= min_g2.get(target);
+        bool pruned_by_vertex = (pruned_by_target == false) && (bottom_right_next_g[1] >= min_g2.get(next_id));
+        expansion.extensions.push_back({next_id, top_left_next_g, bottom_right_next_g, next_h,
+                                        pruned_by_target, pruned_by_vertex});
+    }
+}
+
+
+template<typename HeuristicT>
+void ParallelPPA::prefetch(size_t target, HeuristicT &heuristic) {
+    // Only the path pairs at the front of the queue without a current expansion are computed
+    std::vector<PathPairPtr> candidates;
+    this->workspace->pp_queue.top(this->batch_size, candidates);
+    this->batch.clear();
+    this->batch_slots.clear();
+    for (auto pp = candidates.begin(); pp != candidates.end(); ++pp) {
+        auto slot = this->prefetched.find(*pp);
+        if (slot == this->prefetched.end()) {
+            if (this->free_slots.empty()) {
+                this->free_slots.push_back(this->expansions.size());
+                this->expansions.emplace_back();
+            }
+            slot = this->prefetched.emplace(*pp, this->free_slots.back()).first;
+            this->free_slots.pop_back();
+        } else if ((this->expansions[slot->second].top_left == (*pp)->top_left) &&
+                   (this->expansions[slot->second].bottom_right == (*pp)->bottom_right)) {
+            continue;
+        }
+        this->batch.push_back(*pp);
+        this->batch_slots.push_back(slot->second);
+    }
+
+    // The calling thread waits for the team, so the bounds and the queue are only read meanwhile
+    this->team.run([&](size_t worker_idx) {
+        size_t workers_amount = this->team.size();
+        size_t begin = (this->batch.size()*worker_idx)/workers_amount;
+        size_t end = (this->batch.size()*(worker_idx+1))/workers_amount;
+        for (size_t batch_idx = begin; batch_idx < end; batch_idx++) {
+            this->compute_expansion(this->batch[batch_idx], target, heuristic,
+                                    this->expansions[this->batch_slots[batch_idx]]);
+        }
+    });
+}
+
+
+template<typename HeuristicT>
+void ParallelPPA::operator()(size_t source, size_t target, HeuristicT &heuristic, SolutionSet &solutions,
+                             SearchWorkspace &workspace) {
+    this->start_logging(source, target);
+
+    PPSolutionSet pp_solutions;
+    PathPairPtr   pp;
+    PathPairPtr   next_pp;
+
+    this->workspace = &workspace;
+    workspace.reset(this->adj_matrix.size());
+    this->prefetched.clear();
+    this->free_slots.clear();
+    for (size_t slot = 0; slot < this->expansions.size(); slot++) {
+        this->free_slots.push_back(slot);
+    }
+    size_t pops_since_prefetch = this->batch_size;
+    this->stats = SearchStats();
+    this->stats.heuristic_ns = heuristic_compute_time_ns(heuristic, 0);
+    StatsClock::time_point search_start = StatsClock::now();
+
+    NodePool &nodes = workspace.nodes;
+    PathPairPool &path_pairs = workspace.path_pairs;
+    GenerationArray<size_t> &min_g2 = workspace.min_g2;
+    PPQueue &open = workspace.pp_queue;
+
+    NodePtr source_node = nodes.create(source, Pair<size_t>({0,0}), heuristic(source));
+    pp = path_pairs.create(source_node, source_node);
+    this->stats.nodes_generated++;
+    this->insert(pp, open);
+
+    while (open.empty() == false) {
+        // The front of the queue is computed ahead every quarter batch of pops, path pairs popped
+        // right after they were inserted are expanded on the calling thread
+        if ((this->team.size() > 1) && (pops_since_prefetch >= this->batch_size/4)) {
+            this->prefetch(target, heuristic);
+            pops_since_prefetch = 0;
+        }
+
+        // Pop min from queue and process, as in PPA
+        pp = open.pop();
+        this->stats.heap_pops++;
+        pops_since_prefetch++;
+        Expansion *expansion = nullptr;
+        auto slot = this->prefetched.empty() ? this->prefetched.end() : this->prefetched.find(pp);
+        if (slot != this->prefetched.end()) {
+            // The expansion is stale if a merge changed the nodes of pp since
+            if ((this->expansions[slot->second].top_left == pp->top_left) &&
+                (this->expansions[slot->second].bottom_right == pp->bottom_right)) {
+                expansion = &this->expansions[slot->second];
+            }
+            this->free_slots.push_back(slot->second);
+            this->prefetched.erase(slot);
+        }
+
+        if (((1+this->eps[1])*pp->bottom_right->f[1]) >= min_g2.get(target)) {
+            this->stats.pruned_by_target++;
+            continue;
+        }
+        if (pp->bottom_right->g[1] >= min_g2.get(pp->id)) {
+            this->stats.pruned_by_vertex++;
+            continue;
+        }
+        min_g2.set(pp->id, pp->bottom_right->g[1]);
+
+        if (pp->id == target) {
+            this->merge_to_solutions(pp, pp_solutions);
+            continue;
+        }
+        this->stats.nodes_expanded++;
+
+        if (expansion == nullptr) {
+            expansion = &this->inline_expansion;
+            this->compute_expansion(pp, target, heuristic, *expansion);
+        }
+
+        for (auto extension = expansion->extensions.begin(); extension != expansion->extensions.end(); ++extension) {
+            // Dominance check, marks made ahead hold as the bounds only decrease
+            if (extension->pruned_by_target ||
+                (((1+this->eps[1])*(extension->bottom_right_g[1]+extension->h[1])) >= min_g2.get(target))) {
+                this->stats.pruned_by_target++;
+                continue;
+            }
+            if (extension->pruned_by_vertex || (extension->bottom_right_g[1] >= min_g2.get(extension->id))) {
+                this->stats.pruned_by_vertex++;
+                continue;
+            }
+
+            next_pp = path_pairs.create(
+                            nodes.create(extension->id, extension->top_left_g, extension->h, pp->top_left->handle),
+                            nodes.create(extension->id, extension->bottom_right_g, extension->h, pp->top_left->handle));
+
+            this->stats.nodes_generated++;
+            this->insert(next_pp, open);
+        }
+    }
+    this->stats.search_ns = SearchStats::elapsed_ns(search_start);
+
+    this->finish_search(pp_solutions, solutions, open);
+}
+
+#endif //BI_CRITERIA_PARALLEL_PPA_H
@@ -0,0 +1,176 @@
+#include <atomic>
+#include <thread>
+#include <iterator>
+#include <memory>
+#include <algorithm>
+#include <stdexcept>
+#include <exception>
+#include <mutex>
+
+#include "BatchQueryEngine.h"
+#include "ShortestPathHeuristic.h"
+#include "../Utils/IOUtils.h"
+#include "../BiCriteria/BOAStar.h"
+#include "../BiCriteria/PPA.h"
+
+
+// Everything a worker owns for the whole batch, all of its searches share one workspace
+struct BatchWorker {
+    Logger                                  logger;
+    SearchWorkspace                         workspace;
+    std::vector<std::unique_ptr<BOAStar>>   boa_stars;
+    std::vector<std::unique_ptr<PPA>>       ppas;
+    std::vector<BatchResult>                results;
+    std::vector<std::pair<size_t, std::string>> log_entries;
+
+    BatchWorker(LogFormat log_format) : logger(log_format) {}
+};
+
+
+BatchQueryEngine::BatchQueryEngine(const AdjacencyMatrix &graph, const AdjacencyMatrix &inv_graph, size_t threads_amount,
+                                   size_t heuristic_cache_bytes, bool group_by_target)
+    : graph(graph), inv_graph(inv_graph), threads_amount(threads_amount), group_by_target(group_by_target) {
+    if (this->threads_amount == 0) {
+        this->threads_amount = std::max<size_t>(1, std::thread::hardware_concurrency());
+    }
+    if (heuristic_cache_bytes != 0) {
+        this->heuristic_cache.reset(new HeuristicCache(inv_graph, heuristic_cache_bytes));
+    }
+}
+
+
+void BatchQueryEngine::run(const std::vector<std::pair<size_t, size_t>> &queries, const std::vector<BatchRun> &runs,
+                           std::vector<BatchResult> &results, LoggerPtr logger) {
+    for (auto run = runs.begin(); run != runs.end(); ++run) {
+        if ((run->algorithm != "BOAStar") && (run->algorithm != "PPA")) {
+            throw std::invalid_argument("Unknown batch algorithm " + run->algorithm);
+        }
+    }
+
+    size_t workers_amount = std::min(this->threads_amount, std::max<size_t>(1, queries.size()));
+    std::vector<std::unique_ptr<BatchWorker>> workers;
+    for (size_t i = 0; i < workers_amount; i++) {
+        // Worker entries are appended to the batch logger as is, so they are kept in its format
+        workers.emplace_back(new BatchWorker((logger != nullptr) ? logger->get_format() : LogFormat::JSON));
+        BatchWorker &worker = *workers.back();
+        LoggerPtr worker_logger = (logger != nullptr) ? &worker.logger : nullptr;
+        for (auto run = runs.begin(); run != runs.end(); ++run) {
+            bool is_boa_star = (run->algorithm == "BOAStar");
+            worker.boa_stars.emplace_back(is_boa_star ? new BOAStar(this->graph, {run->eps, run->eps}, worker_logger) : nullptr);
+            worker.ppas.emplace_back(is_boa_star ? nullptr : new PPA(this->graph, {run->eps, run->eps}, worker_logger));
+        }
+    }
+
+    std::vector<size_t> order(queries.size());
+    for (size_t query_idx = 0; query_idx < queries.size(); query_idx++) {
+        order[query_idx] = query_idx;
+    }
+    if (this->group_by_target) {
+        std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+            return queries[a].second < queries[b].second;
+        });
+    }
+
+    // Queries are handed out one by one so long queries don't stall a statically assigned range
+    std::atomic<size_t> next_query(0);
+    // The first exception thrown by a worker, rethrown once all the workers are joined
+    std::exception_ptr worker_exception;
+    std::mutex exception_mutex;
+    auto work = [&](BatchWorker &worker) {
+        try {
+            size_t order_idx;
+            while ((order_idx = next_query++) < queries.size()) {
+                size_t query_idx = order[order_idx];
+                size_t source = queries[query_idx].first;
+                size_t target = queries[query_idx].second;
+
+                HeuristicPtr heuristic = (this->heuristic_cache != nullptr) ? this->heuristic_cache->get(target) :
+                    std::make_shared<const ShortestPathHeuristic>(target, this->graph.size(), this->inv_graph);
+                const ShortestPathHeuristic &sp_heuristic = *heuristic;
+
+                for (size_t run_idx = 0; run_idx < runs.size(); run_idx++) {
+                    SolutionSet solutions;
+                    TimePoint start_time = Clock::now();
+                    if (worker.boa_stars[run_idx] != nullptr) {
+                        (*worker.boa_stars[run_idx])(source, target, sp_heuristic, solutions, worker.workspace);
+                    } else {
+                        (*worker.ppas[run_idx])(source, target, sp_heuristic, solutions, worker.workspace);
+                    }
+                    double runtime_ms = std::chrono::duration<double, std::milli>(Clock::now() - start_time).count();
+
+                    // Solutions point into the search node pool, which is reused by the next query
+                    BatchResult result = {query_idx, run_idx, source, target, {}, runtime_ms};
+                    for (auto solution = solutions.begin(); solution != solutions.end(); ++solution) {
+                        result.solutions.push_back({(*solution)->g[0], (*solution)->g[1]});
+                    }
+                    worker.results.push_back(result);
+                }
+
+                if (logger != nullptr) {
+                    worker.log_entries.emplace_back(query_idx, worker.logger.take_buffered_entries());
+                }
+            }
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(exception_mutex);
+            if (worker_exception == nullptr) {
+                worker_exception = std::current_exception();
+            }
+            // Stops the other workers from taking new queries
+            next_query = queries.size();
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (size_t i = 1; i < workers.size(); i++) {
+        threads.emplace_back(work, std::ref(*workers[i]));
+    }
+    work(*workers[0]);
+    for (auto thread = threads.begin(); thread != threads.end(); ++thread) {
+        thread->join();
+    }
+    if (worker_exception != nullptr) {
+        std::rethrow_exception(worker_exception);
+    }
+
+    // Merge the worker buffers in query order
+    size_t first_result = results.size();
+    std::vector<std::pair<size_t, std::string>> log_entries;
+    for (auto worker = workers.begin(); worker != workers.end(); ++worker) {
+        results.insert(results.end(), (*worker)->results.begin(), (*worker)->results.end());
+        std::move((*worker)->log_entries.begin(), (*worker)->log_entries.end(), std::back_inserter(log_entries));
+    }
+    std::sort(results.begin()+first_result, results.end(), [](const BatchResult &a, const BatchResult &b) {
+        return (a.query_idx != b.query_idx) ? (a.query_idx < b.query_idx) : (a.run_idx < b.run_idx);
+    });
+
+    if (logger != nullptr) {
+        std::sort(log_entries.begin(), log_entries.end(),
+                  [](const std::pair<size_t, std::string> &a, const std::pair<size_t, std::string> &b) {
+            return a.first < b.first;
+        });
+        for (auto entries = log_entries.begin(); entries != log_entries.end(); ++entries) {
+            logger->append_entries(entries->second);
+        }
+    }
+}
+
+
+bool BatchQueryEngine::run(std::string query_file, const std::vector<BatchRun> &runs,
+                           std::vector<BatchResult> &results, LoggerPtr logger) {
+    std::vector<std::pair<size_t, size_t>> queries;
+    if (load_queries(query_file, queries) == false) {
+        return false;
+    }
+    this->run(queries, runs, results, logger);
+    return true;
+}
+
+
+size_t BatchQueryEngine::get_threads_amount() const {
+    return this->threads_amount;
+}
+
+
+HeuristicCacheStats BatchQueryEngine::get_heuristic_cache_stats() const {
+    return (this->heuristic_cache != nullptr) ? this->heuristic_cache->get_stats() : HeuristicCacheStats();
+}
@@ -0,0 +1,58 @@
+#ifndef EXAMPLE_BATCH_QUERY_ENGINE_H
+#define EXAMPLE_BATCH_QUERY_ENGINE_H
+
+#include <string>
+#include <vector>
+#include <memory>
+#include "HeuristicCache.h"
+#include "../Utils/Definitions.h"
+#include "../Utils/Logger.h"
+
+// A single search to run on every query of the batch
+struct BatchRun {
+    std::string     algorithm; // "BOAStar" or "PPA"
+    double          eps;
+};
+
+struct BatchResult {
+    size_t                      query_idx;
+    size_t                      run_idx;
+    size_t                      source;
+    size_t                      target;
+    std::vector<Pair<size_t>>   solutions;  // Costs of the solutions
+    double                      runtime_ms; // Search runtime, excluding the heuristic
+};
+
+// Runs batches of queries on a fixed pool of threads over one shared read only graph.
+// Every worker keeps its own searches and search workspace alive for the whole batch and
+// collects its results and log entries locally. Those are merged in query order at the end.
+// With a heuristic cache the heuristics are shared by all the queries of a target, across runs.
+class BatchQueryEngine {
+private:
+    const AdjacencyMatrix           &graph;
+    const AdjacencyMatrix           &inv_graph;
+    size_t                          threads_amount;
+    bool                            group_by_target;
+    std::unique_ptr<HeuristicCache> heuristic_cache;
+
+public:
+    // threads_amount=0 uses all available cores.
+    // heuristic_cache_bytes=0 computes the heuristic of every query on its own.
+    // group_by_target=true runs the queries of a target one after the other, while the results
+    // keep the query file order.
+    BatchQueryEngine(const AdjacencyMatrix &graph, const AdjacencyMatrix &inv_graph, size_t threads_amount=0,
+                     size_t heuristic_cache_bytes=0, bool group_by_target=false);
+
+    // Results are ordered by query and then by run. An exception thrown by a search stops the batch
+    // and is rethrown here once all the workers have stopped.
+    void run(const std::vector<std::pair<size_t, size_t>> &queries, const std::vector<BatchRun> &runs,
+             std::vector<BatchResult> &results, LoggerPtr logger=nullptr);
+    bool run(std::string query_file, const std::vector<BatchRun> &runs,
+             std::vector<BatchResult> &results, LoggerPtr logger=nullptr);
+
+    size_t get_threads_amount(void) const;
+    // Zeros when the engine has no heuristic cache
+    HeuristicCacheStats get_heuristic_cache_stats(void) const;
+};
+
+#endif // EXAMPLE_BATCH_QUERY_ENGINE_H
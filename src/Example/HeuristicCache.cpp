@@ -0,0 +1,77 @@
+#include <algorithm>
+
+#include "HeuristicCache.h"
+
+
+HeuristicCache::HeuristicCache(const AdjacencyMatrix &inv_graph, size_t budget_bytes)
+    : inv_graph(inv_graph), budget_bytes(budget_bytes) {}
+
+
+void HeuristicCache::evict(size_t needed_bytes) {
+    while ((this->lru.empty() == false) && (this->cached_bytes+needed_bytes > this->budget_bytes)) {
+        auto entry = this->entries.find(this->lru.back());
+        this->cached_bytes -= entry->second.bytes;
+        this->entries.erase(entry);
+        this->lru.pop_back();
+        this->stats.evictions++;
+    }
+}
+
+
+HeuristicPtr HeuristicCache::get(size_t target) {
+    std::unique_lock<std::mutex> lock(this->mutex);
+    auto entry = this->entries.find(target);
+    if (entry != this->entries.end()) {
+        this->lru.splice(this->lru.begin(), this->lru, entry->second.lru_position);
+        this->stats.hits++;
+        std::shared_future<HeuristicPtr> heuristic = entry->second.heuristic;
+        if (heuristic.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+            this->stats.waits++;
+        }
+        lock.unlock();
+        return heuristic.get();
+    }
+
+    // The space is reserved before computing, so concurrent misses don't overshoot the budget together.
+    // A heuristic larger than the whole budget is computed but not cached.
+    this->stats.misses++;
+    std::promise<HeuristicPtr> promise;
+    size_t bytes = ShortestPathHeuristic::memory_bytes(this->inv_graph.size(), false);
+    bool cached = (bytes <= this->budget_bytes);
+    uint64_t computation = ++this->computations;
+    if (cached) {
+        this->evict(bytes);
+        this->lru.push_front(target);
+        this->entries[target] = {promise.get_future().share(), this->lru.begin(), bytes, computation};
+        this->cached_bytes += bytes;
+        this->stats.peak_bytes = std::max(this->stats.peak_bytes, this->cached_bytes);
+    }
+    lock.unlock();
+
+    HeuristicPtr heuristic;
+    try {
+        heuristic = std::make_shared<const ShortestPathHeuristic>(target, this->inv_graph.size(), this->inv_graph);
+    } catch (...) {
+        // Waiting queries get the exception as well, and the next query of the target tries again.
+        // Only the entry of this miss is removed, not one a later miss inserted after it was evicted.
+        promise.set_exception(std::current_exception());
+        if (cached) {
+            lock.lock();
+            entry = this->entries.find(target);
+            if ((entry != this->entries.end()) && (entry->second.computation == computation)) {
+                this->cached_bytes -= entry->second.bytes;
+                this->lru.erase(entry->second.lru_position);
+                this->entries.erase(entry);
+            }
+        }
+        throw;
+    }
+    promise.set_value(heuristic);
+    return heuristic;
+}
+
+
+HeuristicCacheStats HeuristicCache::get_stats(void) {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    return this->stats;
+}
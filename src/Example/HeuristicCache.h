@@ -0,0 +1,57 @@
+#ifndef EXAMPLE_HEURISTIC_CACHE_H
+#define EXAMPLE_HEURISTIC_CACHE_H
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <future>
+#include <unordered_map>
+#include "ShortestPathHeuristic.h"
+#include "../Utils/Definitions.h"
+
+struct HeuristicCacheStats {
+    size_t  hits        = 0;
+    // Hits on a heuristic another query was still computing, counted in hits as well
+    size_t  waits       = 0;
+    size_t  misses      = 0;
+    size_t  evictions   = 0;
+    size_t  peak_bytes  = 0;
+};
+
+using HeuristicPtr = std::shared_ptr<const ShortestPathHeuristic>;
+
+// LRU cache of shortest path heuristics keyed by target, shared by concurrent queries.
+// A heuristic is computed once per target while it stays cached, queries asking for a target
+// that is being computed wait for it instead of computing it again. Least recently used
+// heuristics are evicted to keep the cached tables within the memory budget. Evicted heuristics
+// stay valid for the queries still holding them.
+class HeuristicCache {
+private:
+    struct Entry {
+        std::shared_future<HeuristicPtr>    heuristic;
+        std::list<size_t>::iterator         lru_position;
+        size_t                              bytes;
+        // Miss that inserted the entry, the target may have been evicted and inserted again since
+        uint64_t                            computation;
+    };
+
+    const AdjacencyMatrix                   &inv_graph;
+    size_t                                  budget_bytes;
+    std::mutex                              mutex;
+    std::unordered_map<size_t, Entry>       entries;
+    // Targets from the most to the least recently used
+    std::list<size_t>                       lru;
+    size_t                                  cached_bytes = 0;
+    uint64_t                                computations = 0;
+    HeuristicCacheStats                     stats;
+
+    void evict(size_t needed_bytes);
+
+public:
+    HeuristicCache(const AdjacencyMatrix &inv_graph, size_t budget_bytes);
+
+    HeuristicPtr get(size_t target);
+    HeuristicCacheStats get_stats(void);
+};
+
+#endif // EXAMPLE_HEURISTIC_CACHE_H
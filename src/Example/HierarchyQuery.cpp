@@ -0,0 +1,9 @@
+#include "HierarchyQuery.h"
+
+HierarchyQuery::HierarchyQuery(const ContractionHierarchy &hierarchy, size_t source, size_t target) {
+    StatsClock::time_point compute_start = StatsClock::now();
+    hierarchy.build_query_graph(source, target, this->query_graph);
+    this->heuristic = std::make_shared<ShortestPathHeuristic>(this->query_graph.target, this->query_graph.graph.size(),
+                                                              this->query_graph.inv_graph);
+    this->compute_time_ns = SearchStats::elapsed_ns(compute_start);
+}
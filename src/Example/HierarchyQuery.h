@@ -0,0 +1,42 @@
+#ifndef EXAMPLE_HIERARCHY_QUERY_H
+#define EXAMPLE_HIERARCHY_QUERY_H
+
+#include <memory>
+#include "ShortestPathHeuristic.h"
+#include "../Utils/Definitions.h"
+#include "../Utils/ContractionHierarchy.h"
+
+// Search graph and heuristic of a single query on a contraction hierarchy. The graph holds only the
+// upward search space of the source and the downward search space of the target, numbered in their
+// own ids, so BOAStar, PPA and ParallelPPA searching it go up the hierarchy and then down to the target:
+//     HierarchyQuery query(hierarchy, source, target);
+//     BOAStar search(query.get_graph(), eps);
+//     search(query.get_source(), query.get_target(), query, solutions);
+// The heuristic is exact on this graph, a ShortestPathHeuristic over its inverse, and the time taken
+// to build both is reported as its compute time. Both are sized by the search spaces rather than the
+// graph. Unpack the paths with front.assign(solutions, nodes, &hierarchy, &query.get_query_graph()).
+class HierarchyQuery {
+private:
+    QueryGraph                                      query_graph;
+    std::shared_ptr<const ShortestPathHeuristic>    heuristic;
+    uint64_t                                        compute_time_ns;
+
+public:
+    HierarchyQuery(const ContractionHierarchy &hierarchy, size_t source, size_t target);
+
+    // Valid for as long as the query or any copy of it
+    const AdjacencyMatrix &get_graph(void) const {return this->query_graph.graph;}
+    const QueryGraph &get_query_graph(void) const {return this->query_graph;}
+    // Source and target in the ids of the query graph
+    size_t get_source(void) const {return this->query_graph.source;}
+    size_t get_target(void) const {return this->query_graph.target;}
+
+    Pair<size_t> operator()(size_t node_id) const {
+        return (*this->heuristic)(node_id);
+    }
+
+    // Reported in the search stats of the searches using this heuristic
+    uint64_t get_compute_time_ns(void) const {return this->compute_time_ns;}
+};
+
+#endif // EXAMPLE_HIERARCHY_QUERY_H
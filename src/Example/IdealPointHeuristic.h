@@ -0,0 +1,79 @@
+#ifndef EXAMPLE_IDEAL_POINT_HEURISTIC_H
+#define EXAMPLE_IDEAL_POINT_HEURISTIC_H
+
+#include <vector>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include "../Utils/Definitions.h"
+#include "../Utils/RadixHeap.h"
+#include "../Utils/SearchStats.h"
+
+// N-objective counterpart of ShortestPathHeuristic. Runs a Dijkstra per objective from source and
+// returns the ideal point of each vertex, the shortest path cost of every objective on its own.
+// On call to operator() returns the value of the heuristic in O(1)
+template<size_t N>
+class IdealPointHeuristic {
+private:
+    static const uint32_t           UNREACHABLE = std::numeric_limits<uint32_t>::max();
+
+    std::vector<Costs<uint32_t, N>> h;
+    uint64_t                        compute_time_ns;
+
+    void compute(size_t source, size_t cost_idx, const BasicAdjacencyMatrix<N> &adj_matrix) {
+        RadixHeap<uint32_t> open;
+        this->h[source][cost_idx] = 0;
+        open.push(0, source);
+
+        while (open.empty() == false) {
+            // Lazy deletion, stale entries are skipped on pop
+            RadixHeap<uint32_t>::Entry entry = open.pop();
+            size_t node_id = entry.second;
+            if (entry.first > this->h[node_id][cost_idx]) {
+                continue;
+            }
+
+            const typename BasicAdjacencyMatrix<N>::OutgoingEdges outgoing_edges = adj_matrix[node_id];
+            for (size_t edge_idx = 0; edge_idx < outgoing_edges.size; edge_idx++) {
+                size_t next_id = outgoing_edges.target[edge_idx];
+                uint64_t next_distance = entry.first + outgoing_edges.cost[cost_idx][edge_idx];
+                if (next_distance >= UNREACHABLE) {
+                    throw std::overflow_error("Shortest path cost does not fit in 32 bits");
+                }
+                if (next_distance < this->h[next_id][cost_idx]) {
+                    this->h[next_id][cost_idx] = next_distance;
+                    open.push(next_distance, next_id);
+                }
+            }
+        }
+    }
+
+public:
+    IdealPointHeuristic(size_t source, size_t graph_size, const BasicAdjacencyMatrix<N> &adj_matrix) {
+        StatsClock::time_point compute_start = StatsClock::now();
+        Costs<uint32_t, N> unreachable;
+        unreachable.fill(UNREACHABLE);
+        this->h.assign(graph_size+1, unreachable);
+        for (size_t cost_idx = 0; cost_idx < N; cost_idx++) {
+            this->compute(source, cost_idx, adj_matrix);
+        }
+        this->compute_time_ns = SearchStats::elapsed_ns(compute_start);
+    }
+
+    Costs<size_t, N> operator()(size_t node_id) const {
+        Costs<size_t, N> node_h;
+        for (size_t cost_idx = 0; cost_idx < N; cost_idx++) {
+            uint32_t cost = this->h[node_id][cost_idx];
+            node_h[cost_idx] = (cost == UNREACHABLE) ? MAX_COST : cost;
+        }
+        return node_h;
+    }
+
+    // Reported in the search stats of the searches using this heuristic
+    uint64_t get_compute_time_ns(void) const {return this->compute_time_ns;}
+};
+
+template<size_t N>
+const uint32_t IdealPointHeuristic<N>::UNREACHABLE;
+
+#endif // EXAMPLE_IDEAL_POINT_HEURISTIC_H
@@ -0,0 +1,168 @@
+#include <fstream>
+#include <limits>
+#include <algorithm>
+
+#include "LandmarkHeuristic.h"
+#include "ShortestPathHeuristic.h"
+#include "../Utils/MappedFile.h"
+
+const uint32_t LandmarkTable::UNREACHABLE;
+
+// Landmark file layout, in native byte order validated on load using byte_order_mark:
+//     LandmarkFileHeader
+//     landmarks[landmarks_amount]
+//     distances[(graph_size+1) * 4*landmarks_amount], the rows of LandmarkTable
+// graph_size, edges_count and graph_checksum tie the file to the graph it was built for.
+const char      LANDMARK_FILE_MAGIC[8]          = {'P','P','A','L','N','D','M','K'};
+const uint32_t  LANDMARK_FILE_VERSION           = 2;
+const uint32_t  LANDMARK_FILE_BYTE_ORDER_MARK   = 0x01020304;
+
+struct LandmarkFileHeader {
+    char        magic[8];
+    uint32_t    version;
+    uint32_t    byte_order_mark;
+    uint64_t    graph_size;
+    uint64_t    edges_count;
+    uint64_t    graph_checksum;
+    uint64_t    landmarks_amount;
+};
+
+
+uint32_t to_landmark_cost(size_t cost) {
+    return (cost == MAX_COST) ? LandmarkTable::UNREACHABLE : uint32_t(cost);
+}
+
+
+LandmarkTable::LandmarkTable(const AdjacencyMatrix &graph, const AdjacencyMatrix &inv_graph, size_t landmarks_amount,
+                             bool concurrent)
+    : graph_size(graph.size()), edges_amount(graph.edges_count()), graph_checksum(graph.checksum()),
+      landmarks_amount(std::min(landmarks_amount, graph.size())) {
+    size_t row_size = 4*this->landmarks_amount;
+    std::shared_ptr<std::vector<uint32_t>> buffer = std::make_shared<std::vector<uint32_t>>(
+        this->landmarks_amount + (this->graph_size+1)*row_size, UNREACHABLE);
+    uint32_t *landmarks = buffer->data();
+    uint32_t *distances = landmarks + this->landmarks_amount;
+
+    // Cost 0 from the closest landmark picked so far, the next landmark is the farthest reachable vertex
+    std::vector<uint32_t> min_distance(this->graph_size+1, UNREACHABLE);
+    if (this->graph_size > 0) {
+        ShortestPathHeuristic from_first(1, this->graph_size, graph, concurrent);
+        for (size_t vertex_id = 1; vertex_id <= this->graph_size; vertex_id++) {
+            min_distance[vertex_id] = to_landmark_cost(from_first(vertex_id)[0]);
+        }
+    }
+
+    for (size_t landmark_idx = 0; landmark_idx < this->landmarks_amount; landmark_idx++) {
+        size_t landmark = 1;
+        for (size_t vertex_id = 1; vertex_id <= this->graph_size; vertex_id++) {
+            if ((min_distance[vertex_id] != UNREACHABLE) &&
+                ((min_distance[landmark] == UNREACHABLE) || (min_distance[vertex_id] > min_distance[landmark]))) {
+                landmark = vertex_id;
+            }
+        }
+        landmarks[landmark_idx] = landmark;
+
+        ShortestPathHeuristic from_landmark(landmark, this->graph_size, graph, concurrent);
+        ShortestPathHeuristic to_landmark(landmark, this->graph_size, inv_graph, concurrent);
+        for (size_t vertex_id = 1; vertex_id <= this->graph_size; vertex_id++) {
+            uint32_t *landmark_costs = distances + vertex_id*row_size + 4*landmark_idx;
+            Pair<size_t> from_costs = from_landmark(vertex_id);
+            Pair<size_t> to_costs = to_landmark(vertex_id);
+            landmark_costs[0] = to_landmark_cost(from_costs[0]);
+            landmark_costs[1] = to_landmark_cost(from_costs[1]);
+            landmark_costs[2] = to_landmark_cost(to_costs[0]);
+            landmark_costs[3] = to_landmark_cost(to_costs[1]);
+
+            if (landmark_costs[0] != UNREACHABLE) {
+                min_distance[vertex_id] = (min_distance[vertex_id] == UNREACHABLE) ?
+                                          landmark_costs[0] : std::min(min_distance[vertex_id], landmark_costs[0]);
+            }
+        }
+    }
+
+    this->landmarks = landmarks;
+    this->distances = distances;
+    this->storage = buffer;
+}
+
+
+bool LandmarkTable::save(std::string landmarks_file) const {
+    std::ofstream file(landmarks_file.c_str(), std::ofstream::out | std::ofstream::binary | std::ofstream::trunc);
+    if (file.is_open() == false) {
+        return false;
+    }
+
+    LandmarkFileHeader header;
+    std::copy(LANDMARK_FILE_MAGIC, LANDMARK_FILE_MAGIC+sizeof(header.magic), header.magic);
+    header.version = LANDMARK_FILE_VERSION;
+    header.byte_order_mark = LANDMARK_FILE_BYTE_ORDER_MARK;
+    header.graph_size = this->graph_size;
+    header.edges_count = this->edges_amount;
+    header.graph_checksum = this->graph_checksum;
+    header.landmarks_amount = this->landmarks_amount;
+
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(this->landmarks), this->landmarks_amount*sizeof(uint32_t));
+    file.write(reinterpret_cast<const char*>(this->distances),
+               (this->graph_size+1)*4*this->landmarks_amount*sizeof(uint32_t));
+    return file.good();
+}
+
+
+bool LandmarkTable::load(std::string landmarks_file, const AdjacencyMatrix &graph) {
+    std::shared_ptr<MappedFile> file = std::make_shared<MappedFile>();
+    if ((file->open(landmarks_file) == false) || (file->size() < sizeof(LandmarkFileHeader))) {
+        return false;
+    }
+
+    const LandmarkFileHeader &header = *reinterpret_cast<const LandmarkFileHeader*>(file->data());
+    if ((std::equal(LANDMARK_FILE_MAGIC, LANDMARK_FILE_MAGIC+sizeof(header.magic), header.magic) == false) ||
+        (header.version != LANDMARK_FILE_VERSION) ||
+        (header.byte_order_mark != LANDMARK_FILE_BYTE_ORDER_MARK) ||
+        (header.graph_size != graph.size()) ||
+        (header.edges_count != graph.edges_count()) ||
+        (header.graph_checksum != graph.checksum())) {
+        return false;
+    }
+
+    size_t table_size = (header.landmarks_amount + (header.graph_size+1)*4*header.landmarks_amount)*sizeof(uint32_t);
+    if (file->size() != sizeof(LandmarkFileHeader) + table_size) {
+        return false;
+    }
+
+    this->graph_size = header.graph_size;
+    this->edges_amount = header.edges_count;
+    this->graph_checksum = header.graph_checksum;
+    this->landmarks_amount = header.landmarks_amount;
+    this->landmarks = reinterpret_cast<const uint32_t*>(file->data() + sizeof(LandmarkFileHeader));
+    this->distances = this->landmarks + this->landmarks_amount;
+    this->storage = file;
+    return true;
+}
+
+
+bool load_landmarks_cached(std::string landmarks_file, const AdjacencyMatrix &graph, const AdjacencyMatrix &inv_graph,
+                           size_t landmarks_amount, LandmarkTable &table, bool *built) {
+    if (built != nullptr) {
+        *built = false;
+    }
+    // The table holds at most one landmark per vertex, as clamped when it is built
+    if ((table.load(landmarks_file, graph) == true) &&
+        (table.get_landmarks_amount() == std::min(landmarks_amount, graph.size()))) {
+        return true;
+    }
+
+    table = LandmarkTable(graph, inv_graph, landmarks_amount, true);
+    if (built != nullptr) {
+        *built = true;
+    }
+    return table.save(landmarks_file);
+}
+
+
+LandmarkHeuristic::LandmarkHeuristic(const LandmarkTable &table, size_t target) : table(table) {
+    StatsClock::time_point compute_start = StatsClock::now();
+    const uint32_t *row = table[target];
+    this->target_row.assign(row, row + 4*table.get_landmarks_amount());
+    this->compute_time_ns = SearchStats::elapsed_ns(compute_start);
+}
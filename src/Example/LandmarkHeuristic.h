@@ -0,0 +1,103 @@
+#ifndef EXAMPLE_LANDMARK_HEURISTIC_H
+#define EXAMPLE_LANDMARK_HEURISTIC_H
+
+#include <vector>
+#include <memory>
+#include <string>
+#include <cstdint>
+#include <limits>
+#include <algorithm>
+#include "../Utils/Definitions.h"
+#include "../Utils/SearchStats.h"
+
+// Shortest path costs between a few landmark vertices and every vertex, for both costs.
+// Built once per graph with Dijkstra and saved to disk, where it is memory mapped on load.
+// The costs of a vertex are stored in a row of its own, so a heuristic call reads a single row.
+class LandmarkTable {
+public:
+    // Marks vertices with no path from or to the landmark
+    static const uint32_t       UNREACHABLE = std::numeric_limits<uint32_t>::max();
+
+private:
+    size_t                      graph_size          = 0;
+    size_t                      edges_amount        = 0;
+    uint64_t                    graph_checksum      = 0;
+    size_t                      landmarks_amount    = 0;
+    const uint32_t              *landmarks          = nullptr;
+    const uint32_t              *distances          = nullptr;
+    std::shared_ptr<const void> storage;
+
+public:
+    LandmarkTable() = default;
+    // Picks the landmarks by farthest selection over cost 0, starting from the vertex farthest
+    // from vertex 1. concurrent=true runs the Dijkstra of each cost on a separate thread.
+    LandmarkTable(const AdjacencyMatrix &graph, const AdjacencyMatrix &inv_graph, size_t landmarks_amount,
+                  bool concurrent=false);
+
+    size_t size(void) const {return this->graph_size;}
+    size_t get_landmarks_amount(void) const {return this->landmarks_amount;}
+    size_t get_landmark(size_t landmark_idx) const {return this->landmarks[landmark_idx];}
+
+    // Row of the vertex, holding for every landmark l at [4*l + 2*direction + cost_idx] the cost
+    // from l to the vertex (direction 0) and from the vertex to l (direction 1)
+    const uint32_t *operator[](size_t vertex_id) const {
+        return this->distances + vertex_id*4*this->landmarks_amount;
+    }
+
+    bool save(std::string landmarks_file) const;
+    // Memory maps the table, failing if it was built for a graph of another size
+    bool load(std::string landmarks_file, const AdjacencyMatrix &graph);
+};
+
+// Loads the landmark table, building and saving it first if it can't be loaded.
+// built is set when the table was computed.
+bool load_landmarks_cached(std::string landmarks_file, const AdjacencyMatrix &graph, const AdjacencyMatrix &inv_graph,
+                           size_t landmarks_amount, LandmarkTable &table, bool *built=nullptr);
+
+
+// ALT heuristic towards a target from a precomputed landmark table. By the triangle inequality
+// both c(l,t)-c(l,v) and c(v,l)-c(t,l) bound c(v,t) from below, per cost and landmark.
+// Construction only reads the row of the target, so per query setup needs no Dijkstra,
+// at the cost of weaker bounds than ShortestPathHeuristic. The heuristic is consistent.
+class LandmarkHeuristic {
+private:
+    const LandmarkTable         &table;
+    // Row of the target, see LandmarkTable::operator[]
+    std::vector<uint32_t>       target_row;
+    uint64_t                    compute_time_ns;
+
+public:
+    LandmarkHeuristic(const LandmarkTable &table, size_t target);
+
+    Pair<size_t> operator()(size_t node_id) const {
+        const uint32_t *row = this->table[node_id];
+        const uint32_t *target_row = this->target_row.data();
+        Pair<int64_t> h = {0, 0};
+        for (size_t idx = 0; idx < this->target_row.size(); idx += 4) {
+            for (size_t cost_idx = 0; cost_idx < 2; cost_idx++) {
+                uint32_t from_landmark = row[idx+cost_idx];
+                uint32_t target_from_landmark = target_row[idx+cost_idx];
+                if ((from_landmark != LandmarkTable::UNREACHABLE) && (target_from_landmark != LandmarkTable::UNREACHABLE)) {
+                    h[cost_idx] = std::max(h[cost_idx], int64_t(target_from_landmark) - from_landmark);
+                }
+
+                // The target reaches the landmark but the vertex does not, so it can't reach the target either
+                uint32_t to_landmark = row[idx+2+cost_idx];
+                uint32_t target_to_landmark = target_row[idx+2+cost_idx];
+                if (target_to_landmark == LandmarkTable::UNREACHABLE) {
+                    continue;
+                }
+                if (to_landmark == LandmarkTable::UNREACHABLE) {
+                    return {MAX_COST, MAX_COST};
+                }
+                h[cost_idx] = std::max(h[cost_idx], int64_t(to_landmark) - target_to_landmark);
+            }
+        }
+        return {size_t(h[0]), size_t(h[1])};
+    }
+
+    // Reported in the search stats of the searches using this heuristic
+    uint64_t get_compute_time_ns(void) const {return this->compute_time_ns;}
+};
+
+#endif // EXAMPLE_LANDMARK_HEURISTIC_H
@@ -0,0 +1,91 @@
+#include <stdexcept>
+
+#include "LazyShortestPathHeuristic.h"
+
+const uint32_t LazyShortestPathHeuristic::UNREACHABLE;
+
+
+LazyShortestPathHeuristic::LazyShortestPathHeuristic(size_t source, size_t target, size_t graph_size,
+                                                     const AdjacencyMatrix &adj_matrix)
+    : adj_matrix(adj_matrix) {
+    StatsClock::time_point compute_start = StatsClock::now();
+    for (size_t cost_idx = 0; cost_idx < 2; cost_idx++) {
+        Dijkstra &dijkstra = this->dijkstras[cost_idx];
+        dijkstra.distances.assign(graph_size+1, UNREACHABLE);
+        dijkstra.companions.assign(graph_size+1, UNREACHABLE);
+        dijkstra.distances[target] = 0;
+        dijkstra.companions[target] = 0;
+        dijkstra.open.push(0, target);
+
+        size_t node_id = target;
+        while ((node_id != source) && (node_id != UNREACHABLE)) {
+            node_id = this->settle_next(cost_idx);
+        }
+    }
+
+    // Each Dijkstra is bounded by the other cost of the lexicographically shortest path of the other Dijkstra.
+    // An unreachable source leaves the bounds at 0, the searches find nothing anyway.
+    for (size_t cost_idx = 0; cost_idx < 2; cost_idx++) {
+        uint32_t bound = this->dijkstras[1-cost_idx].companions[source];
+        this->dijkstras[cost_idx].bound = (bound == UNREACHABLE) ? 0 : bound;
+    }
+    this->compute_time_ns = SearchStats::elapsed_ns(compute_start);
+}
+
+
+// Dijkstra step with lazy deletion, keyed by the distance in the upper 32 bits and the companion cost
+// in the lower ones as in ShortestPathHeuristic::compute<true>
+size_t LazyShortestPathHeuristic::settle_next(size_t cost_idx) const {
+    Dijkstra &dijkstra = this->dijkstras[cost_idx];
+    std::vector<uint32_t> &distances = dijkstra.distances;
+    std::vector<uint32_t> &companions = dijkstra.companions;
+
+    while (dijkstra.open.empty() == false) {
+        RadixHeap<uint32_t>::Entry entry = dijkstra.open.pop();
+        size_t node_id = entry.second;
+        if (entry.first > ((uint64_t(distances[node_id]) << 32) | companions[node_id])) {
+            continue;
+        }
+        dijkstra.frontier = distances[node_id];
+        dijkstra.settled++;
+
+        const AdjacencyMatrix::OutgoingEdges outgoing_edges = this->adj_matrix[node_id];
+        const EdgeCost *costs = outgoing_edges.cost[cost_idx];
+        const EdgeCost *companion_costs = outgoing_edges.cost[1-cost_idx];
+        for (size_t edge_idx = 0; edge_idx < outgoing_edges.size; edge_idx++) {
+            size_t next_id = outgoing_edges.target[edge_idx];
+            uint64_t next_distance = uint64_t(distances[node_id]) + costs[edge_idx];
+            uint64_t next_companion = uint64_t(companions[node_id]) + companion_costs[edge_idx];
+            if ((next_distance >= UNREACHABLE) || (next_companion >= UNREACHABLE)) {
+                throw std::overflow_error("Shortest path cost does not fit in 32 bits");
+            }
+
+            // Dominance check
+            uint64_t next_key = (next_distance << 32) | next_companion;
+            if (((uint64_t(distances[next_id]) << 32) | companions[next_id]) <= next_key) {
+                continue;
+            }
+
+            distances[next_id] = next_distance;
+            companions[next_id] = next_companion;
+            dijkstra.open.push(next_key, next_id);
+        }
+        return node_id;
+    }
+    return UNREACHABLE;
+}
+
+
+size_t LazyShortestPathHeuristic::resume(size_t cost_idx, size_t node_id) const {
+    Dijkstra &dijkstra = this->dijkstras[cost_idx];
+    while (dijkstra.distances[node_id] > dijkstra.frontier) {
+        // Past the bound the frontier is a good enough lower bound, the vertex is not on any Pareto solution
+        if (dijkstra.frontier > dijkstra.bound) {
+            return dijkstra.frontier;
+        }
+        if (this->settle_next(cost_idx) == UNREACHABLE) {
+            return MAX_COST;
+        }
+    }
+    return dijkstra.distances[node_id];
+}
@@ -0,0 +1,63 @@
+#ifndef EXAMPLE_LAZY_SHORTEST_PATH_HEURISTIC_H
+#define EXAMPLE_LAZY_SHORTEST_PATH_HEURISTIC_H
+
+#include <vector>
+#include <cstdint>
+#include <limits>
+#include "../Utils/Definitions.h"
+#include "../Utils/RadixHeap.h"
+#include "../Utils/SearchStats.h"
+
+// Shortest path heuristic whose backward Dijkstras run only as far as the search needs them.
+// Construction settles vertices until the query source, which gives for each cost the other cost
+// of its lexicographically shortest source path. No Pareto solution costs more than that,
+// so a Dijkstra stops once its frontier passes that bound.
+// A vertex not settled yet gets the frontier cost, a lower bound of its distance which keeps
+// the heuristic consistent as the frontier only grows. A call for a vertex beyond the frontier
+// resumes the Dijkstra until the vertex is settled or the bound is reached.
+// Calls modify the heuristic, so it must not be shared by concurrent searches.
+class LazyShortestPathHeuristic {
+private:
+    static const uint32_t       UNREACHABLE = std::numeric_limits<uint32_t>::max();
+
+    struct Dijkstra {
+        std::vector<uint32_t>   distances;
+        // Cost of the other objective along the path found, ties of distances are broken by it
+        std::vector<uint32_t>   companions;
+        RadixHeap<uint32_t>     open;
+        // Distance of the last settled vertex, every vertex not settled yet is at least as far
+        uint32_t                frontier    = 0;
+        uint32_t                bound       = UNREACHABLE;
+        size_t                  settled     = 0;
+    };
+
+    const AdjacencyMatrix       &adj_matrix;
+    mutable Dijkstra            dijkstras[2];
+    uint64_t                    compute_time_ns;
+
+    // Settles the next vertex, returning it or UNREACHABLE if there are no more vertices to settle
+    size_t settle_next(size_t cost_idx) const;
+    size_t resume(size_t cost_idx, size_t node_id) const;
+
+    size_t cost(size_t cost_idx, size_t node_id) const {
+        const Dijkstra &dijkstra = this->dijkstras[cost_idx];
+        uint32_t distance = dijkstra.distances[node_id];
+        // A tentative distance not above the frontier is final
+        return (distance <= dijkstra.frontier) ? distance : this->resume(cost_idx, node_id);
+    }
+
+public:
+    // Heuristic towards target over the inverse graph, for a search starting at source
+    LazyShortestPathHeuristic(size_t source, size_t target, size_t graph_size, const AdjacencyMatrix &adj_matrix);
+
+    Pair<size_t> operator()(size_t node_id) const {
+        return {this->cost(0, node_id), this->cost(1, node_id)};
+    }
+
+    // Vertices settled so far by the Dijkstra of the cost
+    size_t get_settled_amount(size_t cost_idx) const {return this->dijkstras[cost_idx].settled;}
+    // Reported in the search stats of the searches using this heuristic, later resumes are part of the search
+    uint64_t get_compute_time_ns(void) const {return this->compute_time_ns;}
+};
+
+#endif // EXAMPLE_LAZY_SHORTEST_PATH_HEURISTIC_H
@@ -1,67 +1,112 @@
 #include <limits>
-#include <memory>
-#include <algorithm>
+#include <thread>
+#include <stdexcept>
 
 #include "ShortestPathHeuristic.h"
-
-
-ShortestPathHeuristic::ShortestPathHeuristic(size_t source, size_t graph_size, const AdjacencyMatrix &adj_matrix)
-    : source(source), all_nodes(graph_size+1, nullptr) {
-    size_t i = 0;
-    for (auto node_iter = this->all_nodes.begin(); node_iter != this->all_nodes.end(); node_iter++) {
-        *node_iter = std::make_shared<Node>(i++, Pair<size_t>({0,0}), Pair<size_t>({MAX_COST,MAX_COST}));
+#include "../Utils/RadixHeap.h"
+
+const uint32_t ShortestPathHeuristic::UNREACHABLE;
+
+ShortestPathHeuristic::ShortestPathHeuristic(size_t source, size_t graph_size, const AdjacencyMatrix &adj_matrix,
+                                             bool concurrent, bool with_paths)
+    : source(source), h(graph_size+1) {
+    StatsClock::time_point compute_start = StatsClock::now();
+    Pair<std::vector<uint32_t>> distances;
+    Pair<std::vector<uint32_t>> companions;
+    Pair<std::vector<uint32_t>> parents;
+
+    auto compute = with_paths ? &ShortestPathHeuristic::compute<true> : &ShortestPathHeuristic::compute<false>;
+    if (concurrent) {
+        std::thread cost1_thread(compute, this, 1, std::cref(adj_matrix),
+                                 std::ref(distances[1]), std::ref(companions[1]), std::ref(parents[1]));
+        (this->*compute)(0, adj_matrix, distances[0], companions[0], parents[0]);
+        cost1_thread.join();
+    } else {
+        (this->*compute)(0, adj_matrix, distances[0], companions[0], parents[0]);
+        (this->*compute)(1, adj_matrix, distances[1], companions[1], parents[1]);
     }
 
-    compute(0, adj_matrix);
-    compute(1, adj_matrix);
-}
-
+    // Each Dijkstra works on its own array, so both costs of a vertex are interleaved only at the end
+    for (size_t i = 0; i <= graph_size; i++) {
+        this->h[i] = {distances[0][i], distances[1][i]};
+    }
 
-Pair<size_t> ShortestPathHeuristic::operator()(size_t node_id) {
-    return this->all_nodes[node_id]->h;
+    // The path found for a cost is shortest for both costs if its companion cost is the other shortest path cost
+    if (with_paths) {
+        this->path_next.resize(graph_size+1);
+        for (size_t i = 0; i <= graph_size; i++) {
+            this->path_next[i] = {(companions[0][i] == distances[1][i]) ? parents[0][i] : UNREACHABLE,
+                                  (companions[1][i] == distances[0][i]) ? parents[1][i] : UNREACHABLE};
+        }
+    }
+    this->compute_time_ns = SearchStats::elapsed_ns(compute_start);
 }
 
 
-// Implements Dijkstra shortest path algorithm per cost_idx cost function
-void ShortestPathHeuristic::compute(size_t cost_idx, const AdjacencyMatrix &adj_matrix) {
-    // Init all heuristics to MAX_COST
-    for (auto node_iter = this->all_nodes.begin(); node_iter != this->all_nodes.end(); node_iter++) {
-        (*node_iter)->h[cost_idx] = MAX_COST;
+// Implements Dijkstra shortest path algorithm per cost_idx cost function, using a radix heap
+// with lazy deletion (stale entries are skipped on pop).
+// WITH_PATHS breaks ties by the other cost, whose cost along the path is kept in companions,
+// and keeps the shortest path tree in parents.
+template<bool WITH_PATHS>
+void ShortestPathHeuristic::compute(size_t cost_idx, const AdjacencyMatrix &adj_matrix, std::vector<uint32_t> &distances,
+                                    std::vector<uint32_t> &companions, std::vector<uint32_t> &parents) const {
+    distances.assign(adj_matrix.size()+1, UNREACHABLE);
+    if (WITH_PATHS) {
+        companions.assign(adj_matrix.size()+1, UNREACHABLE);
+        parents.assign(adj_matrix.size()+1, UNREACHABLE);
+        companions[this->source] = 0;
+        parents[this->source] = this->source;
     }
 
-    NodePtr node;
-    NodePtr next;
-
-    // Init open heap
-    Node::more_than_specific_heurisitic_cost more_than(cost_idx);
-    std::vector<NodePtr> open;
-    std::make_heap(open.begin(), open.end(), more_than);
-
-    this->all_nodes[this->source]->h[cost_idx] = 0;
-    open.push_back(this->all_nodes[this->source]);
-    std::push_heap(open.begin(), open.end(), more_than);
+    // With paths the key holds the distance in its upper 32 bits and the companion cost in the lower ones
+    auto key = [&](size_t node_id) -> uint64_t {
+        return WITH_PATHS ? ((uint64_t(distances[node_id]) << 32) | companions[node_id]) : distances[node_id];
+    };
 
+    RadixHeap<uint32_t> open;
+    distances[this->source] = 0;
+    open.push(0, this->source);
 
     while (open.empty() == false) {
         // Pop min from queue and process
-        std::pop_heap(open.begin(), open.end(), more_than);
-        node = open.back();
-        open.pop_back();
+        RadixHeap<uint32_t>::Entry entry = open.pop();
+        size_t node_id = entry.second;
+        if (entry.first > key(node_id)) {
+            continue;
+        }
+        uint64_t node_distance = distances[node_id];
 
         // Check to which neighbors we should extend the paths
-        const std::vector<Edge> &outgoing_edges = adj_matrix[node->id];
-        for(auto p_edge = outgoing_edges.begin(); p_edge != outgoing_edges.end(); p_edge++) {
-            next = this->all_nodes[p_edge->target];
+        const AdjacencyMatrix::OutgoingEdges outgoing_edges = adj_matrix[node_id];
+        const EdgeCost *costs = outgoing_edges.cost[cost_idx];
+        const EdgeCost *companion_costs = outgoing_edges.cost[1-cost_idx];
+        for (size_t edge_idx = 0; edge_idx < outgoing_edges.size; edge_idx++) {
+            size_t next_id = outgoing_edges.target[edge_idx];
+            uint64_t next_distance = node_distance + costs[edge_idx];
+            uint64_t next_key = next_distance;
+            if (WITH_PATHS) {
+                uint64_t next_companion = uint64_t(companions[node_id]) + companion_costs[edge_idx];
+                if (next_companion >= UNREACHABLE) {
+                    throw std::overflow_error("Shortest path cost does not fit in 32 bits");
+                }
+                next_key = (next_distance << 32) | next_companion;
+            }
 
             // Dominance check
-            if (next->h[cost_idx] <= (node->h[cost_idx]+p_edge->cost[cost_idx])) {
+            if (key(next_id) <= next_key) {
                 continue;
             }
+            if (next_distance >= UNREACHABLE) {
+                throw std::overflow_error("Shortest path cost does not fit in 32 bits");
+            }
 
             // If not dominated push to queue
-            next->h[cost_idx] = node->h[cost_idx] + p_edge->cost[cost_idx];
-            open.push_back(next);
-            std::push_heap(open.begin(), open.end(), more_than);
+            distances[next_id] = next_distance;
+            if (WITH_PATHS) {
+                companions[next_id] = next_key & UNREACHABLE;
+                parents[next_id] = node_id;
+            }
+            open.push(next_key, next_id);
         }
     }
 }
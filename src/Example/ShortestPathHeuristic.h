@@ -1,19 +1,57 @@
 #ifndef EXAMPLE_SHORTEST_PATH_HEURISTIC_H
 #define EXAMPLE_SHORTEST_PATH_HEURISTIC_H
 
+#include <vector>
+#include <cstdint>
 #include "../Utils/Definitions.h"
+#include "../Utils/SearchStats.h"
 
 // Precalculates heuristic based on Dijkstra shortest paths algorithm.
 // On call to operator() returns the value of the heuristic in O(1)
 class ShortestPathHeuristic {
 private:
-    size_t                  source;
-    std::vector<NodePtr>    all_nodes;
+    // Shortest path costs are kept in 32 bits, UNREACHABLE marks vertices with no path to source
+    static const uint32_t       UNREACHABLE = std::numeric_limits<uint32_t>::max();
 
-    void compute(size_t cost_idx, const AdjacencyMatrix& adj_matrix);
+    size_t                      source;
+    std::vector<Pair<uint32_t>> h;
+    // Per cost, next vertex towards source on a path shortest for that cost which is shortest for the other
+    // cost as well, UNREACHABLE if the path found is not. Kept only when constructed with paths.
+    std::vector<Pair<uint32_t>> path_next;
+    uint64_t                    compute_time_ns;
+
+    template<bool WITH_PATHS>
+    void compute(size_t cost_idx, const AdjacencyMatrix &adj_matrix, std::vector<uint32_t> &distances,
+                 std::vector<uint32_t> &companions, std::vector<uint32_t> &parents) const;
 public:
-    ShortestPathHeuristic(size_t source, size_t graph_size, const AdjacencyMatrix &adj_matrix);
-    Pair<size_t> operator()(size_t node_id);
+    // concurrent=true runs the Dijkstra of each cost on a separate thread.
+    // with_paths=true also keeps the paths needed by dominant_path_next().
+    ShortestPathHeuristic(size_t source, size_t graph_size, const AdjacencyMatrix &adj_matrix, bool concurrent=false,
+                          bool with_paths=false);
+
+    Pair<size_t> operator()(size_t node_id) const {
+        const Pair<uint32_t> &node_h = this->h[node_id];
+        return {node_h[0] == UNREACHABLE ? MAX_COST : node_h[0],
+                node_h[1] == UNREACHABLE ? MAX_COST : node_h[1]};
+    }
+
+    // Next vertex on a path between node_id and source which is shortest for both costs, found by
+    // breaking the ties of the cost_idx shortest paths by the other cost. NO_PATH if there is none.
+    size_t dominant_path_next(size_t cost_idx, size_t node_id) const {
+        if (this->path_next.empty()) {
+            return NO_PATH;
+        }
+        uint32_t next = this->path_next[node_id][cost_idx];
+        return (next == UNREACHABLE) ? NO_PATH : next;
+    }
+
+    // Reported in the search stats of the searches using this heuristic
+    uint64_t get_compute_time_ns(void) const {return this->compute_time_ns;}
+
+    // Memory held by a heuristic over a graph of graph_size vertices
+    static size_t memory_bytes(size_t graph_size, bool with_paths) {
+        return (graph_size+1)*sizeof(Pair<uint32_t>)*(with_paths ? 2 : 1);
+    }
 };
 
-#endif // EXAMPLE_SHORTEST_PATH_HEURISTIC_H
\ No newline at end of file
+#endif // EXAMPLE_SHORTEST_PATH_HEURISTIC_H
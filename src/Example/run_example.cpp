@@ -1,65 +1,106 @@
 #include <iostream>
 #include <memory>
+#include <algorithm>
 
 #include "ShortestPathHeuristic.h"
+#include "BatchQueryEngine.h"
+#include "HeuristicCache.h"
 #include "../Utils/Definitions.h"
 #include "../Utils/IOUtils.h"
 #include "../Utils/Logger.h"
+#include "../Utils/ParetoFront.h"
+#include "../Utils/SearchWorkspace.h"
 #include "../BiCriteria/BOAStar.h"
 #include "../BiCriteria/PPA.h"
+#include "../BiCriteria/BOBAStar.h"
 
 const std::string resource_path = "src/Example/Resources/";
+// Memory budget of the heuristics cached across the queries of a map
+const size_t heuristic_cache_bytes = size_t(1) << 30;
+
+
+// Loads the map from its binary graph cache, converting the gr files into a cache on first use
+bool load_map(std::string map, AdjacencyMatrix &graph, AdjacencyMatrix &inv_graph) {
+    LoadStats stats;
+    if (load_gr_files_cached(resource_path+"USA-road-d."+map+".gr", resource_path+"USA-road-t."+map+".gr",
+                             resource_path+"USA-road-"+map+".graph", graph, inv_graph, &stats) == false) {
+        return false;
+    }
+    if (stats.bytes != 0) {
+        std::cout << "Converted gr files to graph cache, parsed " << stats.bytes << " bytes in " << stats.seconds
+                  << "s on " << stats.threads << " threads (" << stats.throughput_mb_per_sec() << " MB/s)" << std::endl;
+    }
+    return true;
+}
+
 
 // Simple example to demonstarte the usage of the algorithm
 void single_run_ny_map(size_t source, size_t target, double eps, LoggerPtr logger) {
     std::cout << "-----Start NY Map Single Example: SRC=" << source << " DEST=" << target << " EPS=" << eps << "-----" << std::endl;
 
-    // Load files
-    size_t graph_size;
-    std::vector<Edge> edges;
-    if (load_gr_files(resource_path+"USA-road-d.NY.gr", resource_path+"USA-road-t.NY.gr", edges, graph_size) == false) {
+    // Load graphs
+    AdjacencyMatrix graph;
+    AdjacencyMatrix inv_graph;
+    if (load_map("NY", graph, inv_graph) == false) {
         std::cout << "Failed to load gr files" << std::endl;
         return;
     }
+    size_t graph_size = graph.size();
 
     std::cout << "Graph Size: " << graph_size << std::endl;
 
-    // Build graphs
-    AdjacencyMatrix graph(graph_size, edges);
-    AdjacencyMatrix inv_graph(graph_size, edges, true);
-
     // Compute heuristic
     std::cout << "Start Computing Heuristic" << std::endl;
-    ShortestPathHeuristic sp_heuristic(target, graph_size, inv_graph);
+    ShortestPathHeuristic sp_heuristic(target, graph_size, inv_graph, true);
     std::cout << "Finish Computing Heuristic\n" << std::endl;
 
-    using std::placeholders::_1;
-    Heuristic heuristic = std::bind( &ShortestPathHeuristic::operator(), sp_heuristic, _1);
 
     // Compute BOAStar
     std::cout << "Start Computing BOAStar" << std::endl;
     SolutionSet boa_solutions;
     BOAStar boa_star(graph, {eps,eps}, logger);
-    boa_star(source, target, heuristic, boa_solutions);
+    boa_star(source, target, sp_heuristic, boa_solutions);
     std::cout << "Finish Computing BOAStar" << std::endl;
 
     std::cout << "BOAStar Solutions:" << std::endl;
     size_t solutions_count = 0;
     for (auto solution = boa_solutions.begin(); solution != boa_solutions.end(); solution++) {
-        std::cout << ++solutions_count << ". " << *(*solution) << std::endl;
+        std::cout << ++solutions_count << ". " << PooledNode{**solution, boa_star.get_nodes()} << std::endl;
     }
     std::cout << std::endl;
 
-    // Compute PPA
+    // Compute PPA, its solutions are copied with their paths into a Pareto front so the search memory
+    // can be released right away
     std::cout << "Start Computing PPA" << std::endl;
     SolutionSet ppa_solutions;
+    SearchWorkspace ppa_workspace;
+    ParetoFront ppa_front;
     PPA ppa(graph, {eps,eps}, logger);
-    ppa(source, target, heuristic, ppa_solutions);
+    ppa(source, target, sp_heuristic, ppa_solutions, ppa_workspace);
+    ppa_front.assign(ppa_solutions, ppa_workspace.nodes);
+    ppa_workspace.release();
     std::cout << "Finish Computing PPA" << std::endl;
 
+    for (size_t solution_idx = 0; solution_idx < ppa_front.size(); solution_idx++) {
+        ParetoFront::Path path = ppa_front.get_path(solution_idx);
+        std::cout << solution_idx+1 << ". " << "{\"costs\": " << ppa_front.get_costs(solution_idx) << ", "
+                  << "\"path_source\": " << path.vertices[0] << ", \"path_target\": " << path.vertices[path.size-1] << ", "
+                  << "\"path_vertices\": " << path.size << "}" << std::endl;
+    }
+    std::cout << std::endl;
+
+    // Compute BOBAStar, its heuristics also record the dominant paths used for early solution detection
+    std::cout << "Start Computing BOBAStar" << std::endl;
+    ShortestPathHeuristic forward_heuristic(target, graph_size, inv_graph, true, true);
+    ShortestPathHeuristic backward_heuristic(source, graph_size, graph, true, true);
+    SolutionSet boba_solutions;
+    BOBAStar boba_star(graph, inv_graph, logger, true);
+    boba_star(source, target, forward_heuristic, backward_heuristic, boba_solutions);
+    std::cout << "Finish Computing BOBAStar" << std::endl;
+
     solutions_count = 0;
-    for (auto solution = ppa_solutions.begin(); solution != ppa_solutions.end(); solution++) {
-        std::cout << ++solutions_count << ". " << *(*solution) << std::endl;
+    for (auto solution = boba_solutions.begin(); solution != boba_solutions.end(); solution++) {
+        std::cout << ++solutions_count << ". " << PooledNode{**solution, boba_star.get_nodes()} << std::endl;
     }
     std::cout << std::endl;
 
@@ -70,10 +111,10 @@ void single_run_ny_map(size_t source, size_t target, double eps, LoggerPtr logge
 void run_queries(std::string map, double eps, LoggerPtr logger) {
     std::cout << "-----Start " << map << " Map Queries Example: EPS=" << eps << "-----" << std::endl;
 
-    // Load files
-    size_t graph_size;
-    std::vector<Edge> edges;
-    if (load_gr_files(resource_path+"USA-road-d."+map+".gr", resource_path+"USA-road-t."+map+".gr", edges, graph_size) == false) {
+    // Load graphs
+    AdjacencyMatrix graph;
+    AdjacencyMatrix inv_graph;
+    if (load_map(map, graph, inv_graph) == false) {
         std::cout << "Failed to load gr files" << std::endl;
         return;
     }
@@ -84,9 +125,8 @@ void run_queries(std::string map, double eps, LoggerPtr logger) {
         return;
     }
 
-    // Build graphs
-    AdjacencyMatrix graph(graph_size, edges);
-    AdjacencyMatrix inv_graph(graph_size, edges, true);
+    // Queries sharing a target reuse its heuristic
+    HeuristicCache heuristic_cache(inv_graph, heuristic_cache_bytes);
 
     size_t query_count = 0;
     for (auto iter = queries.begin(); iter != queries.end(); ++iter) {
@@ -94,57 +134,129 @@ void run_queries(std::string map, double eps, LoggerPtr logger) {
         size_t source = iter->first;
         size_t target = iter->second;
 
-        ShortestPathHeuristic sp_heuristic(target, graph_size, inv_graph);
+        HeuristicPtr heuristic = heuristic_cache.get(target);
+        const ShortestPathHeuristic &sp_heuristic = *heuristic;
 
-        using std::placeholders::_1;
-        Heuristic heuristic = std::bind( &ShortestPathHeuristic::operator(), sp_heuristic, _1);
 
         SolutionSet boa_solutions;
         BOAStar boa_star(graph, {eps,eps}, logger);
-        boa_star(source, target, heuristic, boa_solutions);
+        boa_star(source, target, sp_heuristic, boa_solutions);
 
         SolutionSet ppa_solutions;
         PPA ppa(graph, {eps,eps}, logger);
-        ppa(source, target, heuristic, ppa_solutions);
+        ppa(source, target, sp_heuristic, ppa_solutions);
     }
 
+    HeuristicCacheStats cache_stats = heuristic_cache.get_stats();
+    std::cout << "Heuristic cache hits: " << cache_stats.hits << " misses: " << cache_stats.misses << std::endl;
     std::cout << "-----End " << map << " Map Queries Example-----" << std::endl;
 }
 
 
+// Runs BOAStar and PPA with every eps over all the queries of a map, using all cores
+void run_queries_batch(std::string map, std::vector<double> eps_list, LoggerPtr logger) {
+    std::cout << "-----Start " << map << " Map Batch Queries Example-----" << std::endl;
+
+    AdjacencyMatrix graph;
+    AdjacencyMatrix inv_graph;
+    if (load_map(map, graph, inv_graph) == false) {
+        std::cout << "Failed to load gr files" << std::endl;
+        return;
+    }
+
+    std::vector<BatchRun> runs;
+    for (auto eps = eps_list.begin(); eps != eps_list.end(); ++eps) {
+        runs.push_back({"BOAStar", *eps});
+        runs.push_back({"PPA", *eps});
+    }
+
+    BatchQueryEngine engine(graph, inv_graph, 0, heuristic_cache_bytes, true);
+    std::vector<BatchResult> results;
+    TimePoint start_time = Clock::now();
+    if (engine.run(resource_path+"USA-road-"+map+"-queries", runs, results, logger) == false) {
+        std::cout << "Failed to load queries file" << std::endl;
+        return;
+    }
+
+    std::cout << "Finished " << results.size() << " searches on " << engine.get_threads_amount() << " threads in "
+              << std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - start_time).count() << "ms" << std::endl;
+    HeuristicCacheStats cache_stats = engine.get_heuristic_cache_stats();
+    std::cout << "Heuristic cache hits: " << cache_stats.hits << " misses: " << cache_stats.misses
+              << " evictions: " << cache_stats.evictions << std::endl;
+    std::cout << "-----End " << map << " Map Batch Queries Example-----" << std::endl;
+}
+
+
+// Compares the runtime of BOAStar open list policies over the queries of a map
+void benchmark_open_lists(std::string map, double eps) {
+    std::cout << "-----Start " << map << " Map Open List Benchmark: EPS=" << eps << "-----" << std::endl;
+
+    AdjacencyMatrix graph;
+    AdjacencyMatrix inv_graph;
+    if (load_map(map, graph, inv_graph) == false) {
+        std::cout << "Failed to load gr files" << std::endl;
+        return;
+    }
+
+    std::vector<std::pair<size_t, size_t>> queries;
+    if (load_queries(resource_path+"USA-road-"+map+"-queries", queries) == false) {
+        std::cout << "Failed to load queries file" << std::endl;
+        return;
+    }
+
+    const std::vector<std::pair<std::string, OpenListType>> open_lists = {
+        {"BinaryHeap", OpenListType::BINARY_HEAP},
+        {"RadixHeap", OpenListType::RADIX_HEAP}
+    };
+    std::vector<double> total_runtime_ms(open_lists.size(), 0);
+
+    for (auto iter = queries.begin(); iter != queries.end(); ++iter) {
+        ShortestPathHeuristic sp_heuristic(iter->second, graph.size(), inv_graph);
+
+
+        std::vector<size_t> solutions_amount;
+        for (size_t i = 0; i < open_lists.size(); i++) {
+            SolutionSet solutions;
+            BOAStar boa_star(graph, {eps,eps}, nullptr, open_lists[i].second);
+
+            TimePoint start_time = Clock::now();
+            boa_star(iter->first, iter->second, sp_heuristic, solutions);
+            total_runtime_ms[i] += std::chrono::duration<double, std::milli>(Clock::now() - start_time).count();
+            solutions_amount.push_back(solutions.size());
+        }
+
+        if (std::equal(solutions_amount.begin()+1, solutions_amount.end(), solutions_amount.begin()) == false) {
+            std::cout << "Solutions mismatch on query " << iter->first << "->" << iter->second << std::endl;
+        }
+    }
+
+    for (size_t i = 0; i < open_lists.size(); i++) {
+        std::cout << open_lists[i].first << " total runtime(ms): " << total_runtime_ms[i] << std::endl;
+    }
+
+    std::cout << "-----End " << map << " Map Open List Benchmark-----" << std::endl;
+}
+
+
 // Run all queries on all availible maps. The logs outputed from this function are
 // used for running the tests
 void run_all_queries(void) {
+    std::vector<double> eps_list = {0.1, 0.05, 0.025, 0.01, 0};
+
     LoggerPtr logger_bay = new Logger("queries_BAY_log.json");
-    run_queries("BAY", 0.1, logger_bay);
-    run_queries("BAY", 0.05, logger_bay);
-    run_queries("BAY", 0.025, logger_bay);
-    run_queries("BAY", 0.01, logger_bay);
-    run_queries("BAY", 0, logger_bay);
+    run_queries_batch("BAY", eps_list, logger_bay);
     delete logger_bay;
 
     LoggerPtr logger_col = new Logger("queries_COL_log.json");
-    run_queries("COL", 0.1, logger_col);
-    run_queries("COL", 0.05, logger_col);
-    run_queries("COL", 0.025, logger_col);
-    run_queries("COL", 0.01, logger_col);
-    run_queries("COL", 0, logger_col);
+    run_queries_batch("COL", eps_list, logger_col);
     delete logger_col;
 
     LoggerPtr logger_ne = new Logger("queries_NE_log.json");
-    run_queries("NE", 0.1, logger_ne);
-    run_queries("NE", 0.05, logger_ne);
-    run_queries("NE", 0.025, logger_ne);
-    run_queries("NE", 0.01, logger_ne);
-    run_queries("NE", 0, logger_ne);
+    run_queries_batch("NE", eps_list, logger_ne);
     delete logger_ne;
 
     LoggerPtr logger_ny = new Logger("queries_NY_log.json");
-    run_queries("NY", 0.1, logger_ny);
-    run_queries("NY", 0.05, logger_ny);
-    run_queries("NY", 0.025, logger_ny);
-    run_queries("NY", 0.01, logger_ny);
-    run_queries("NY", 0, logger_ny);
+    run_queries_batch("NY", eps_list, logger_ny);
     delete logger_ny;
 }
 
@@ -162,6 +274,11 @@ int main(void) {
     single_run_ny_map(hard_source, hard_target, 0, logger);
     delete logger;
 
+    // benchmark_open_lists("BAY", 0);
+    // benchmark_open_lists("COL", 0);
+    // benchmark_open_lists("NE", 0);
+    // benchmark_open_lists("NY", 0);
+
     // try {
     //     run_all_queries();
     // } catch (const std::exception &e) {
@@ -0,0 +1,202 @@
+#ifndef MULTI_CRITERIA_MOA_STAR_H
+#define MULTI_CRITERIA_MOA_STAR_H
+
+#include <vector>
+#include <queue>
+#include <algorithm>
+#include "../Utils/Definitions.h"
+#include "../Utils/GenerationArray.h"
+#include "../Utils/SearchStats.h"
+
+// Multi-objective A* over N objectives, generalizing BOAStar in the way of EMOA*.
+// Nodes are popped in lexicographic order of their full costs, so the first cost of the paths
+// reaching a vertex never decreases. A node is then dominated exactly when the costs of the other
+// N-1 objectives are dominated by a path that already reached the vertex. Each vertex keeps
+// those truncated costs as a nondominated set, which for N=2 is the min_g2 of BOAStar.
+// Path costs are kept in CostT, the bi-objective searches use the specialized BOAStar and PPA.
+template<typename CostT, size_t N>
+class MOAStar {
+public:
+    using NodeType      = BasicNode<CostT, N>;
+    using NodePtrType   = NodeType*;
+    using NodePoolType  = Arena<NodeType>;
+    using SolutionsType = std::vector<NodePtrType>;
+
+private:
+    using Truncated     = Costs<CostT, N-1>;
+
+    // Entry of the per vertex nondominated sets, linked through the truncated pool
+    struct TruncatedEntry {
+        Truncated   cost;
+        uint32_t    next;
+    };
+
+    static const uint32_t   NO_ENTRY = std::numeric_limits<uint32_t>::max();
+
+    const BasicAdjacencyMatrix<N>   &adj_matrix;
+    Costs<double, N>                eps;
+    NodePoolType                    nodes;
+    std::vector<TruncatedEntry>     truncated;
+    GenerationArray<uint32_t>       truncated_head;
+    SearchStats                     stats;
+
+    static Truncated truncate(const Costs<size_t, N> &cost) {
+        Truncated truncated_cost;
+        for (size_t i = 1; i < N; i++) {
+            truncated_cost[i-1] = to_saturated_cost<CostT>(cost[i]);
+        }
+        return truncated_cost;
+    }
+
+    static bool weakly_dominates(const Truncated &a, const Truncated &b) {
+        for (size_t i = 0; i+1 < N; i++) {
+            if (a[i] > b[i]) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // A solution bounds f if (1+eps) times f is not better than the solution in any objective.
+    // Later solutions are checked first, they are the best in the objectives past the first one.
+    bool is_bounded_by_solutions(const Costs<size_t, N> &f, const SolutionsType &solutions) const {
+        for (auto solution = solutions.rbegin(); solution != solutions.rend(); ++solution) {
+            size_t i = 1;
+            while ((i < N) && ((1+this->eps[i])*f[i] >= (*solution)->g[i])) {
+                i++;
+            }
+            if (i == N) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool is_dominated_at_vertex(size_t node_id, const Truncated &g) const {
+        for (uint32_t idx = this->truncated_head.get(node_id); idx != NO_ENTRY; idx = this->truncated[idx].next) {
+            if (weakly_dominates(this->truncated[idx].cost, g)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Adds g to the nondominated set of the vertex, removing the entries it dominates
+    void add_to_vertex(size_t node_id, const Truncated &g) {
+        uint32_t head = this->truncated_head.get(node_id);
+        uint32_t *link = &head;
+        while (*link != NO_ENTRY) {
+            TruncatedEntry &entry = this->truncated[*link];
+            if (weakly_dominates(g, entry.cost)) {
+                *link = entry.next;
+            } else {
+                link = &entry.next;
+            }
+        }
+        this->truncated.push_back({g, head});
+        this->truncated_head.set(node_id, this->truncated.size()-1);
+    }
+
+public:
+    MOAStar(const BasicAdjacencyMatrix<N> &adj_matrix, Costs<double, N> eps)
+        : adj_matrix(adj_matrix), eps(eps), truncated_head(NO_ENTRY) {}
+
+    // Solutions point into the node pool and remain valid until the next search.
+    // The heuristic can be any functor taking a vertex id and returning Costs<size_t, N>.
+    template<typename HeuristicT>
+    void operator()(size_t source, size_t target, HeuristicT &heuristic, SolutionsType &solutions);
+
+    // Node pool of the last search
+    const NodePoolType &get_nodes() const {return this->nodes;}
+    // Stats of the last search
+    const SearchStats &get_stats() const {return this->stats;}
+};
+
+template<typename CostT, size_t N>
+const uint32_t MOAStar<CostT, N>::NO_ENTRY;
+
+
+template<typename CostT, size_t N>
+template<typename HeuristicT>
+void MOAStar<CostT, N>::operator()(size_t source, size_t target, HeuristicT &heuristic, SolutionsType &solutions) {
+    this->nodes.clear();
+    this->truncated.clear();
+    this->truncated_head.reset(this->adj_matrix.size()+1);
+    this->stats = SearchStats();
+    this->stats.heuristic_ns = heuristic_compute_time_ns(heuristic, 0);
+    StatsClock::time_point search_start = StatsClock::now();
+
+    std::priority_queue<NodePtrType, std::vector<NodePtrType>, typename NodeType::more_than_full_cost> open;
+    Costs<size_t, N> zero = {};
+    open.push(this->nodes.create(source, zero, heuristic(source)));
+    this->stats.nodes_generated++;
+    this->stats.heap_pushes++;
+    this->stats.peak_open_size = 1;
+
+    while (open.empty() == false) {
+        NodePtrType node = open.top();
+        open.pop();
+        this->stats.heap_pops++;
+
+        Costs<size_t, N> node_f;
+        Costs<size_t, N> node_g;
+        std::copy(node->f.begin(), node->f.end(), node_f.begin());
+        std::copy(node->g.begin(), node->g.end(), node_g.begin());
+
+        // Dominance check
+        if (this->is_bounded_by_solutions(node_f, solutions)) {
+            this->stats.pruned_by_target++;
+            continue;
+        }
+        Truncated node_truncated = truncate(node_g);
+        if (this->is_dominated_at_vertex(node->id, node_truncated)) {
+            this->stats.pruned_by_vertex++;
+            continue;
+        }
+        this->add_to_vertex(node->id, node_truncated);
+
+        if (node->id == target) {
+            solutions.push_back(node);
+            continue;
+        }
+        this->stats.nodes_expanded++;
+
+        const typename BasicAdjacencyMatrix<N>::OutgoingEdges outgoing_edges = this->adj_matrix[node->id];
+        for (size_t edge_idx = 0; edge_idx < outgoing_edges.size; edge_idx++) {
+            size_t next_id = outgoing_edges.target[edge_idx];
+            Costs<size_t, N> next_h = heuristic(next_id);
+            if (std::find(next_h.begin(), next_h.end(), MAX_COST) != next_h.end()) {
+                continue; // The target is unreachable from next_id
+            }
+
+            Costs<size_t, N> next_g;
+            Costs<size_t, N> next_f;
+            for (size_t i = 0; i < N; i++) {
+                next_g[i] = node_g[i] + outgoing_edges.cost[i][edge_idx];
+                next_f[i] = next_g[i] + next_h[i];
+            }
+
+            // Dominance check
+            if (this->is_bounded_by_solutions(next_f, solutions)) {
+                this->stats.pruned_by_target++;
+                continue;
+            }
+            if (this->is_dominated_at_vertex(next_id, truncate(next_g))) {
+                this->stats.pruned_by_vertex++;
+                continue;
+            }
+
+            open.push(this->nodes.create(next_id, next_g, next_h, node->handle));
+            this->stats.nodes_generated++;
+            this->stats.heap_pushes++;
+            this->stats.peak_open_size = std::max(this->stats.peak_open_size, open.size());
+        }
+    }
+
+    this->stats.search_ns = SearchStats::elapsed_ns(search_start);
+    this->stats.peak_memory_bytes = this->nodes.size()*sizeof(NodeType) +
+                                    this->truncated.size()*sizeof(TruncatedEntry) +
+                                    this->stats.peak_open_size*sizeof(NodePtrType);
+}
+
+#endif //MULTI_CRITERIA_MOA_STAR_H
@@ -0,0 +1,69 @@
+#ifndef UTILS_ARENA_H
+#define UTILS_ARENA_H
+
+#include <vector>
+#include <memory>
+#include <limits>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+
+using Handle = uint32_t;
+const Handle NULL_HANDLE = std::numeric_limits<Handle>::max();
+
+// Per-search arena of objects addressed by compact 32-bit handles.
+// Objects are stored in fixed size blocks so addresses stay stable while the arena grows,
+// and clear() only rewinds the allocation counter - blocks are reused by the next search.
+template<typename T>
+class Arena {
+private:
+    static const size_t BLOCK_BITS = 16;
+    static const size_t BLOCK_SIZE = size_t(1) << BLOCK_BITS;
+    static const size_t BLOCK_MASK = BLOCK_SIZE - 1;
+
+    using Storage = typename std::aligned_storage<sizeof(T), alignof(T)>::type;
+
+    std::vector<std::unique_ptr<Storage[]>> blocks;
+    size_t                                  count = 0;
+
+    static_assert(std::is_trivially_destructible<T>::value,
+                  "Arena objects are never destructed, clear() just rewinds the arena");
+
+public:
+    Arena() = default;
+    Arena(const Arena &) = delete;
+    Arena &operator=(const Arena &) = delete;
+
+    template<typename... Args>
+    T *create(Args&&... args) {
+        if (this->count >= NULL_HANDLE) {
+            throw std::length_error("Arena exceeded the amount of addressable handles");
+        }
+        if ((this->count >> BLOCK_BITS) == this->blocks.size()) {
+            this->blocks.emplace_back(new Storage[BLOCK_SIZE]);
+        }
+        Handle handle = static_cast<Handle>(this->count++);
+        void *slot = &this->blocks[handle >> BLOCK_BITS][handle & BLOCK_MASK];
+        return new (slot) T(handle, std::forward<Args>(args)...);
+    }
+
+    T &operator[](Handle handle) {
+        return *reinterpret_cast<T*>(&this->blocks[handle >> BLOCK_BITS][handle & BLOCK_MASK]);
+    }
+
+    const T &operator[](Handle handle) const {
+        return *reinterpret_cast<const T*>(&this->blocks[handle >> BLOCK_BITS][handle & BLOCK_MASK]);
+    }
+
+    size_t size(void) const {return this->count;}
+
+    void clear(void) {this->count = 0;}
+
+    // Unlike clear() frees the blocks as well, for when the memory is not going to be reused
+    void release(void) {
+        std::vector<std::unique_ptr<Storage[]>>().swap(this->blocks);
+        this->count = 0;
+    }
+};
+
+#endif //UTILS_ARENA_H
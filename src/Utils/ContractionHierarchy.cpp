@@ -0,0 +1,583 @@
+#include <fstream>
+#include <algorithm>
+#include <functional>
+#include <queue>
+#include <stdexcept>
+#include <unordered_map>
+
+#include "ContractionHierarchy.h"
+#include "GenerationArray.h"
+#include "MappedFile.h"
+
+const uint32_t ContractionHierarchy::NO_VIA;
+
+// Hierarchy file layout, in native byte order validated on load using byte_order_mark.
+// Both graphs are stored as CSR columns of uint32 values, followed by the via vertex of each edge:
+//     HierarchyFileHeader
+//     up:         offsets[graph_size+2], targets[up_edges], costs0[up_edges], costs1[up_edges], via[up_edges]
+//     inv_down:   offsets[graph_size+2], targets[down_edges], costs0[down_edges], costs1[down_edges], via[down_edges]
+// graph_size, edges_count and graph_checksum tie the file to the graph it was built for.
+const char      HIERARCHY_FILE_MAGIC[8]         = {'P','P','A','H','I','E','R','C'};
+const uint32_t  HIERARCHY_FILE_VERSION          = 2;
+const uint32_t  HIERARCHY_FILE_BYTE_ORDER_MARK  = 0x01020304;
+
+struct HierarchyFileHeader {
+    char        magic[8];
+    uint32_t    version;
+    uint32_t    byte_order_mark;
+    uint64_t    graph_size;
+    uint64_t    edges_count;
+    uint64_t    graph_checksum;
+    uint64_t    core_size;
+    uint64_t    up_edges;
+    uint64_t    down_edges;
+};
+
+
+// Edge of the graph being contracted, vertex is the head of outgoing edges and the tail of incoming ones
+struct ContractionEdge {
+    uint32_t        vertex;
+    uint32_t        via;
+    Pair<size_t>    cost;
+};
+
+struct Shortcut {
+    uint32_t        source;
+    uint32_t        target;
+    Pair<size_t>    cost;
+};
+
+
+bool weakly_dominates(const Pair<size_t> &a, const Pair<size_t> &b) {
+    return (a[0] <= b[0]) && (a[1] <= b[1]);
+}
+
+
+// Contracts a copy of the graph held as adjacency lists, which shrink as vertices are contracted.
+// The edges of each contracted vertex to the remaining vertices are moved to up and inv_down.
+class HierarchyBuilder {
+private:
+    struct Label {
+        Pair<size_t>    g;
+        uint32_t        vertex;
+
+        bool operator>(const Label &other) const {
+            return (this->g[0] != other.g[0]) ? (this->g[0] > other.g[0]) : (this->g[1] > other.g[1]);
+        }
+    };
+
+    struct Candidate {
+        uint32_t        target;
+        Pair<size_t>    cost;
+        bool            witnessed;
+    };
+
+    const ContractionOptions                    &options;
+    std::vector<std::vector<ContractionEdge>>   out;
+    std::vector<std::vector<ContractionEdge>>   in;
+    std::vector<char>                           contracted;
+    std::vector<uint32_t>                       contracted_neighbors;
+    size_t                                      remaining_vertices;
+    size_t                                      remaining_edges = 0;
+
+    // Witness search scratch, kept between the searches
+    GenerationArray<size_t>                     min_g2;
+    std::vector<Label>                          open;
+    std::vector<Candidate>                      candidates;
+
+    // Adds the edge unless a parallel edge weakly dominates it, removing the parallel edges it dominates
+    void add_edge(size_t source, size_t target, const Pair<size_t> &cost, uint32_t via) {
+        std::vector<ContractionEdge> &source_out = this->out[source];
+        for (auto edge = source_out.begin(); edge != source_out.end(); ++edge) {
+            if ((edge->vertex == target) && weakly_dominates(edge->cost, cost)) {
+                return;
+            }
+        }
+
+        size_t out_size = source_out.size();
+        source_out.erase(std::remove_if(source_out.begin(), source_out.end(), [&](const ContractionEdge &edge) {
+            return (edge.vertex == target) && weakly_dominates(cost, edge.cost);
+        }), source_out.end());
+        std::vector<ContractionEdge> &target_in = this->in[target];
+        target_in.erase(std::remove_if(target_in.begin(), target_in.end(), [&](const ContractionEdge &edge) {
+            return (edge.vertex == source) && weakly_dominates(cost, edge.cost);
+        }), target_in.end());
+        this->remaining_edges -= out_size - source_out.size();
+
+        source_out.push_back({uint32_t(target), via, cost});
+        target_in.push_back({uint32_t(source), via, cost});
+        this->remaining_edges++;
+    }
+
+    // Bi-objective Dijkstra from source avoiding the vertex being contracted, popping labels in
+    // lexicographic order like BOAStar with a zero heuristic. Marks the candidates whose costs are
+    // weakly dominated by a path it finds, and gives up after witness_settled_limit labels.
+    void witness_search(size_t source, size_t avoided) {
+        Pair<size_t> max_cost = {0, 0};
+        for (auto candidate = this->candidates.begin(); candidate != this->candidates.end(); ++candidate) {
+            max_cost = {std::max(max_cost[0], candidate->cost[0]), std::max(max_cost[1], candidate->cost[1])};
+        }
+        size_t unwitnessed = this->candidates.size();
+
+        this->min_g2.reset(this->out.size());
+        this->open.clear();
+        this->open.push_back({{0, 0}, uint32_t(source)});
+        size_t settled = 0;
+
+        while ((this->open.empty() == false) && (unwitnessed > 0) && (settled < this->options.witness_settled_limit)) {
+            std::pop_heap(this->open.begin(), this->open.end(), std::greater<Label>());
+            Label label = this->open.back();
+            this->open.pop_back();
+
+            if (label.g[0] > max_cost[0]) {
+                break;
+            }
+            if (label.g[1] >= this->min_g2.get(label.vertex)) {
+                continue;
+            }
+            this->min_g2.set(label.vertex, label.g[1]);
+            settled++;
+
+            for (auto candidate = this->candidates.begin(); candidate != this->candidates.end(); ++candidate) {
+                if ((candidate->witnessed == false) && (candidate->target == label.vertex) &&
+                    weakly_dominates(label.g, candidate->cost)) {
+                    candidate->witnessed = true;
+                    unwitnessed--;
+                }
+            }
+
+            const std::vector<ContractionEdge> &edges = this->out[label.vertex];
+            for (auto edge = edges.begin(); edge != edges.end(); ++edge) {
+                Pair<size_t> next_g = {label.g[0] + edge->cost[0], label.g[1] + edge->cost[1]};
+                if ((edge->vertex == avoided) || (next_g[1] > max_cost[1]) || (next_g[1] >= this->min_g2.get(edge->vertex))) {
+                    continue;
+                }
+                this->open.push_back({next_g, edge->vertex});
+                std::push_heap(this->open.begin(), this->open.end(), std::greater<Label>());
+            }
+        }
+    }
+
+    // Shortcuts needed to contract the vertex, per tail of its incoming edges
+    void find_shortcuts(size_t vertex, std::vector<Shortcut> &shortcuts) {
+        const std::vector<ContractionEdge> &vertex_in = this->in[vertex];
+        const std::vector<ContractionEdge> &vertex_out = this->out[vertex];
+
+        for (size_t in_idx = 0; in_idx < vertex_in.size(); in_idx++) {
+            // Parallel incoming edges are handled together with the first one
+            uint32_t source = vertex_in[in_idx].vertex;
+            bool handled = false;
+            for (size_t prev_idx = 0; prev_idx < in_idx; prev_idx++) {
+                handled = handled || (vertex_in[prev_idx].vertex == source);
+            }
+            if (handled) {
+                continue;
+            }
+
+            // Candidates dominated by another candidate to the same vertex are not needed
+            this->candidates.clear();
+            for (size_t edge_idx = in_idx; edge_idx < vertex_in.size(); edge_idx++) {
+                if (vertex_in[edge_idx].vertex != source) {
+                    continue;
+                }
+                for (auto edge = vertex_out.begin(); edge != vertex_out.end(); ++edge) {
+                    if (edge->vertex == source) {
+                        continue;
+                    }
+                    Pair<size_t> cost = {vertex_in[edge_idx].cost[0] + edge->cost[0],
+                                         vertex_in[edge_idx].cost[1] + edge->cost[1]};
+                    bool dominated = false;
+                    for (auto candidate = this->candidates.begin(); candidate != this->candidates.end(); ++candidate) {
+                        dominated = dominated || ((candidate->target == edge->vertex) && weakly_dominates(candidate->cost, cost));
+                    }
+                    if (dominated) {
+                        continue;
+                    }
+                    this->candidates.erase(std::remove_if(this->candidates.begin(), this->candidates.end(),
+                        [&](const Candidate &candidate) {
+                            return (candidate.target == edge->vertex) && weakly_dominates(cost, candidate.cost);
+                        }), this->candidates.end());
+                    this->candidates.push_back({edge->vertex, cost, false});
+                }
+            }
+            if (this->candidates.empty()) {
+                continue;
+            }
+
+            this->witness_search(source, vertex);
+            for (auto candidate = this->candidates.begin(); candidate != this->candidates.end(); ++candidate) {
+                if (candidate->witnessed == false) {
+                    shortcuts.push_back({source, candidate->target, candidate->cost});
+                }
+            }
+        }
+    }
+
+    // Edge difference, plus the contracted neighbors which spreads the contraction over the graph
+    int64_t priority(size_t vertex, const std::vector<Shortcut> &shortcuts) const {
+        return int64_t(shortcuts.size()) - int64_t(this->in[vertex].size() + this->out[vertex].size()) +
+               this->contracted_neighbors[vertex];
+    }
+
+    void contract(size_t vertex, const std::vector<Shortcut> &shortcuts) {
+        std::vector<ContractionEdge> &vertex_in = this->in[vertex];
+        std::vector<ContractionEdge> &vertex_out = this->out[vertex];
+        auto to_vertex = [&](const ContractionEdge &edge) {return edge.vertex == vertex;};
+
+        for (auto edge = vertex_in.begin(); edge != vertex_in.end(); ++edge) {
+            std::vector<ContractionEdge> &source_out = this->out[edge->vertex];
+            source_out.erase(std::remove_if(source_out.begin(), source_out.end(), to_vertex), source_out.end());
+            this->contracted_neighbors[edge->vertex]++;
+        }
+        for (auto edge = vertex_out.begin(); edge != vertex_out.end(); ++edge) {
+            std::vector<ContractionEdge> &target_in = this->in[edge->vertex];
+            target_in.erase(std::remove_if(target_in.begin(), target_in.end(), to_vertex), target_in.end());
+            this->contracted_neighbors[edge->vertex]++;
+        }
+
+        this->remaining_edges -= vertex_in.size() + vertex_out.size();
+        this->remaining_vertices--;
+        this->contracted[vertex] = true;
+        this->inv_down[vertex].swap(vertex_in);
+        this->up[vertex].swap(vertex_out);
+
+        for (auto shortcut = shortcuts.begin(); shortcut != shortcuts.end(); ++shortcut) {
+            this->add_edge(shortcut->source, shortcut->target, shortcut->cost, vertex);
+        }
+    }
+
+public:
+    std::vector<std::vector<ContractionEdge>>   up;
+    std::vector<std::vector<ContractionEdge>>   inv_down;
+    size_t                                      core_size = 0;
+
+    HierarchyBuilder(const AdjacencyMatrix &graph, const ContractionOptions &options)
+        : options(options), out(graph.size()+1), in(graph.size()+1), contracted(graph.size()+1, false),
+          contracted_neighbors(graph.size()+1, 0), remaining_vertices(graph.size()+1), min_g2(MAX_COST),
+          up(graph.size()+1), inv_down(graph.size()+1) {
+        for (size_t vertex = 0; vertex <= graph.size(); vertex++) {
+            const AdjacencyMatrix::OutgoingEdges outgoing_edges = graph[vertex];
+            for (size_t edge_idx = 0; edge_idx < outgoing_edges.size; edge_idx++) {
+                if (outgoing_edges.target[edge_idx] != vertex) {
+                    this->add_edge(vertex, outgoing_edges.target[edge_idx],
+                                   {outgoing_edges.cost[0][edge_idx], outgoing_edges.cost[1][edge_idx]},
+                                   ContractionHierarchy::NO_VIA);
+                }
+            }
+        }
+    }
+
+    void build(void) {
+        // Min heap of priorities, which are updated lazily when a vertex is popped
+        using Entry = std::pair<int64_t, uint32_t>;
+        std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> queue;
+        std::vector<Shortcut> shortcuts;
+        for (size_t vertex = 0; vertex < this->out.size(); vertex++) {
+            shortcuts.clear();
+            this->find_shortcuts(vertex, shortcuts);
+            queue.push({this->priority(vertex, shortcuts), vertex});
+        }
+
+        while ((queue.empty() == false) &&
+               (this->remaining_edges <= this->options.core_degree*this->remaining_vertices)) {
+            uint32_t vertex = queue.top().second;
+            queue.pop();
+
+            shortcuts.clear();
+            this->find_shortcuts(vertex, shortcuts);
+            int64_t vertex_priority = this->priority(vertex, shortcuts);
+            if ((queue.empty() == false) && (vertex_priority > queue.top().first)) {
+                queue.push({vertex_priority, vertex});
+                continue;
+            }
+            this->contract(vertex, shortcuts);
+        }
+
+        // The core is searched as is, its edges going either way
+        for (size_t vertex = 0; vertex < this->out.size(); vertex++) {
+            if (this->contracted[vertex] == false) {
+                this->up[vertex].swap(this->out[vertex]);
+                this->core_size++;
+            }
+        }
+    }
+};
+
+
+// Flattens the adjacency lists into a CSR graph, appending the via vertices of its edges in CSR order
+AdjacencyMatrix to_adjacency_matrix(size_t graph_size, const std::vector<std::vector<ContractionEdge>> &lists,
+                                    std::vector<uint32_t> &via) {
+    std::vector<Edge> edges;
+    for (size_t vertex = 0; vertex < lists.size(); vertex++) {
+        for (auto edge = lists[vertex].begin(); edge != lists[vertex].end(); ++edge) {
+            edges.emplace_back(vertex, edge->vertex, edge->cost);
+            via.push_back(edge->via);
+        }
+    }
+    return AdjacencyMatrix(graph_size, edges);
+}
+
+
+ContractionHierarchy::ContractionHierarchy(const AdjacencyMatrix &graph, const AdjacencyMatrix &inv_graph,
+                                           const ContractionOptions &options)
+    : graph_edges(graph.edges_count()), graph_checksum(graph.checksum()) {
+    if (graph.size() != inv_graph.size()) {
+        throw std::invalid_argument("Graph and inverse graph differ in size");
+    }
+    HierarchyBuilder builder(graph, options);
+    builder.build();
+    this->core_amount = builder.core_size;
+
+    std::shared_ptr<std::vector<uint32_t>> via = std::make_shared<std::vector<uint32_t>>();
+    this->up = to_adjacency_matrix(graph.size(), builder.up, *via);
+    this->inv_down = to_adjacency_matrix(graph.size(), builder.inv_down, *via);
+    this->up_via = via->data();
+    this->inv_down_via = this->up_via + this->up.edges_count();
+    this->storage = via;
+}
+
+
+void ContractionHierarchy::build_query_graph(size_t source, size_t target, QueryGraph &query_graph) const {
+    // Query graph id of each reached vertex and the search spaces it was reached in, which is the
+    // only per vertex state, so the work is in the size of the search spaces and not of the graph.
+    struct QueryVertex {
+        uint32_t    id;
+        uint8_t     search_spaces;
+    };
+    std::unordered_map<uint32_t, QueryVertex> query_vertices;
+    std::vector<uint32_t> &vertices = query_graph.vertices;
+    vertices.assign(1, 0);
+
+    // Both search spaces are found by a depth first search, the downward one backwards from target.
+    // Vertices get their query graph id when first reached, and the edges are copied once their amount
+    // is known, each vertex in expanded followed by the query graph ids of its edge targets.
+    std::vector<uint32_t> expanded;
+    std::vector<uint32_t> edge_targets;
+    auto find_search_space = [&](size_t root, const AdjacencyMatrix &hierarchy_graph, uint8_t search_space) {
+        auto reach = [&](size_t vertex) {
+            auto entry = query_vertices.find(vertex);
+            if (entry == query_vertices.end()) {
+                entry = query_vertices.emplace(vertex, QueryVertex{uint32_t(vertices.size()), 0}).first;
+                vertices.push_back(vertex);
+            }
+            bool first_reached = (entry->second.search_spaces & search_space) == 0;
+            entry->second.search_spaces |= search_space;
+            return std::make_pair(entry->second.id, first_reached);
+        };
+
+        std::vector<uint32_t> stack(1, root);
+        reach(root);
+        while (stack.empty() == false) {
+            size_t vertex = stack.back();
+            stack.pop_back();
+            expanded.push_back(vertex);
+
+            const AdjacencyMatrix::OutgoingEdges outgoing_edges = hierarchy_graph[vertex];
+            for (size_t edge_idx = 0; edge_idx < outgoing_edges.size; edge_idx++) {
+                std::pair<uint32_t, bool> next = reach(outgoing_edges.target[edge_idx]);
+                edge_targets.push_back(next.first);
+                if (next.second == true) {
+                    stack.push_back(outgoing_edges.target[edge_idx]);
+                }
+            }
+        }
+    };
+    find_search_space(source, this->up, 1);
+    size_t up_expanded = expanded.size();
+    find_search_space(target, this->inv_down, 2);
+
+    std::vector<Edge> edges;
+    edges.reserve(edge_targets.size());
+    auto edge_target = edge_targets.begin();
+    for (size_t expanded_idx = 0; expanded_idx < expanded.size(); expanded_idx++) {
+        bool inverse = expanded_idx >= up_expanded;
+        size_t vertex_id = query_vertices[expanded[expanded_idx]].id;
+        const AdjacencyMatrix::OutgoingEdges outgoing_edges = (inverse ? this->inv_down : this->up)[expanded[expanded_idx]];
+        for (size_t edge_idx = 0; edge_idx < outgoing_edges.size; edge_idx++, ++edge_target) {
+            Pair<size_t> cost = {outgoing_edges.cost[0][edge_idx], outgoing_edges.cost[1][edge_idx]};
+            edges.emplace_back(inverse ? *edge_target : vertex_id, inverse ? vertex_id : *edge_target, cost);
+        }
+    }
+
+    query_graph.source = query_vertices[source].id;
+    query_graph.target = query_vertices[target].id;
+    AdjacencyMatrix::build_with_inverse(vertices.size()-1, edges, query_graph.graph, query_graph.inv_graph);
+}
+
+
+uint32_t ContractionHierarchy::find_via(size_t source, size_t target, const Pair<size_t> &cost) const {
+    const AdjacencyMatrix::OutgoingEdges up_edges = this->up[source];
+    for (size_t edge_idx = 0; edge_idx < up_edges.size; edge_idx++) {
+        if ((up_edges.target[edge_idx] == target) &&
+            (up_edges.cost[0][edge_idx] == cost[0]) && (up_edges.cost[1][edge_idx] == cost[1])) {
+            return this->up_via[this->up.get_offsets()[source] + edge_idx];
+        }
+    }
+    const AdjacencyMatrix::OutgoingEdges down_edges = this->inv_down[target];
+    for (size_t edge_idx = 0; edge_idx < down_edges.size; edge_idx++) {
+        if ((down_edges.target[edge_idx] == source) &&
+            (down_edges.cost[0][edge_idx] == cost[0]) && (down_edges.cost[1][edge_idx] == cost[1])) {
+            return this->inv_down_via[this->inv_down.get_offsets()[target] + edge_idx];
+        }
+    }
+    throw std::invalid_argument("Edge is not part of the contraction hierarchy");
+}
+
+
+void ContractionHierarchy::unpack_edge(size_t source, size_t target, const Pair<size_t> &cost,
+                                       std::vector<uint32_t> &vertices) const {
+    uint32_t via = this->find_via(source, target, cost);
+    if (via == NO_VIA) {
+        vertices.push_back(target);
+        return;
+    }
+
+    // Both edges of the shortcut were kept with via when it was contracted, source->via as a
+    // downward edge and via->target as an upward one. Any pair adding up to the cost will do.
+    const AdjacencyMatrix::OutgoingEdges down_edges = this->inv_down[via];
+    const AdjacencyMatrix::OutgoingEdges up_edges = this->up[via];
+    for (size_t down_idx = 0; down_idx < down_edges.size; down_idx++) {
+        if (down_edges.target[down_idx] != source) {
+            continue;
+        }
+        Pair<size_t> down_cost = {down_edges.cost[0][down_idx], down_edges.cost[1][down_idx]};
+        for (size_t up_idx = 0; up_idx < up_edges.size; up_idx++) {
+            if ((up_edges.target[up_idx] == target) &&
+                (down_cost[0] + up_edges.cost[0][up_idx] == cost[0]) &&
+                (down_cost[1] + up_edges.cost[1][up_idx] == cost[1])) {
+                this->unpack_edge(source, via, down_cost, vertices);
+                this->unpack_edge(via, target, {up_edges.cost[0][up_idx], up_edges.cost[1][up_idx]}, vertices);
+                return;
+            }
+        }
+    }
+    throw std::invalid_argument("Shortcut edges are missing from the contraction hierarchy");
+}
+
+
+size_t hierarchy_columns_size(uint64_t graph_size, uint64_t edges_count) {
+    return ((graph_size+2) + 4*edges_count) * sizeof(uint32_t);
+}
+
+
+void write_hierarchy_columns(std::ofstream &file, const AdjacencyMatrix &graph, const uint32_t *via) {
+    file.write(reinterpret_cast<const char*>(graph.get_offsets()), (graph.size()+2)*sizeof(uint32_t));
+    file.write(reinterpret_cast<const char*>(graph.get_targets()), graph.edges_count()*sizeof(uint32_t));
+    file.write(reinterpret_cast<const char*>(graph.get_costs(0)), graph.edges_count()*sizeof(EdgeCost));
+    file.write(reinterpret_cast<const char*>(graph.get_costs(1)), graph.edges_count()*sizeof(EdgeCost));
+    file.write(reinterpret_cast<const char*>(via), graph.edges_count()*sizeof(uint32_t));
+}
+
+
+AdjacencyMatrix read_hierarchy_columns(const char *data, uint64_t graph_size, uint64_t edges_count,
+                                       const std::shared_ptr<const void> &storage, const uint32_t *&via) {
+    const uint32_t *offsets = reinterpret_cast<const uint32_t*>(data);
+    const uint32_t *targets = offsets + (graph_size+2);
+    const EdgeCost *costs0 = reinterpret_cast<const EdgeCost*>(targets + edges_count);
+    const EdgeCost *costs1 = costs0 + edges_count;
+    via = reinterpret_cast<const uint32_t*>(costs1 + edges_count);
+    return AdjacencyMatrix(graph_size, edges_count, offsets, targets, {costs0, costs1}, storage);
+}
+
+
+bool valid_via(const uint32_t *via, size_t edges_count, size_t graph_size) {
+    for (size_t edge_idx = 0; edge_idx < edges_count; edge_idx++) {
+        if ((via[edge_idx] != ContractionHierarchy::NO_VIA) && (via[edge_idx] > graph_size)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+
+bool ContractionHierarchy::save(std::string hierarchy_file) const {
+    std::ofstream file(hierarchy_file.c_str(), std::ofstream::out | std::ofstream::binary | std::ofstream::trunc);
+    if (file.is_open() == false) {
+        return false;
+    }
+
+    HierarchyFileHeader header;
+    std::copy(HIERARCHY_FILE_MAGIC, HIERARCHY_FILE_MAGIC+sizeof(header.magic), header.magic);
+    header.version = HIERARCHY_FILE_VERSION;
+    header.byte_order_mark = HIERARCHY_FILE_BYTE_ORDER_MARK;
+    header.graph_size = this->size();
+    header.edges_count = this->graph_edges;
+    header.graph_checksum = this->graph_checksum;
+    header.core_size = this->core_amount;
+    header.up_edges = this->up.edges_count();
+    header.down_edges = this->inv_down.edges_count();
+
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    write_hierarchy_columns(file, this->up, this->up_via);
+    write_hierarchy_columns(file, this->inv_down, this->inv_down_via);
+    return file.good();
+}
+
+
+bool ContractionHierarchy::load(std::string hierarchy_file, const AdjacencyMatrix &graph) {
+    std::shared_ptr<MappedFile> file = std::make_shared<MappedFile>();
+    if ((file->open(hierarchy_file) == false) || (file->size() < sizeof(HierarchyFileHeader))) {
+        return false;
+    }
+
+    const HierarchyFileHeader &header = *reinterpret_cast<const HierarchyFileHeader*>(file->data());
+    if ((std::equal(HIERARCHY_FILE_MAGIC, HIERARCHY_FILE_MAGIC+sizeof(header.magic), header.magic) == false) ||
+        (header.version != HIERARCHY_FILE_VERSION) ||
+        (header.byte_order_mark != HIERARCHY_FILE_BYTE_ORDER_MARK) ||
+        (header.graph_size != graph.size()) ||
+        (header.edges_count != graph.edges_count()) ||
+        (header.graph_checksum != graph.checksum())) {
+        return false;
+    }
+
+    size_t up_size = hierarchy_columns_size(header.graph_size, header.up_edges);
+    size_t down_size = hierarchy_columns_size(header.graph_size, header.down_edges);
+    if (file->size() != sizeof(HierarchyFileHeader) + up_size + down_size) {
+        return false;
+    }
+
+    const char *columns_data = file->data() + sizeof(HierarchyFileHeader);
+    const uint32_t *up_via;
+    const uint32_t *inv_down_via;
+    AdjacencyMatrix up = read_hierarchy_columns(columns_data, header.graph_size, header.up_edges, file, up_via);
+    AdjacencyMatrix inv_down = read_hierarchy_columns(columns_data + up_size, header.graph_size, header.down_edges,
+                                                      file, inv_down_via);
+    if ((up.is_valid() == false) || (inv_down.is_valid() == false) ||
+        (valid_via(up_via, header.up_edges, header.graph_size) == false) ||
+        (valid_via(inv_down_via, header.down_edges, header.graph_size) == false)) {
+        return false;
+    }
+
+    this->graph_edges = header.edges_count;
+    this->graph_checksum = header.graph_checksum;
+    this->core_amount = header.core_size;
+    this->up = up;
+    this->inv_down = inv_down;
+    this->up_via = up_via;
+    this->inv_down_via = inv_down_via;
+    this->storage = file;
+    return true;
+}
+
+
+size_t ContractionHierarchy::memory_bytes() const {
+    return hierarchy_columns_size(this->size(), this->up.edges_count()) +
+           hierarchy_columns_size(this->size(), this->inv_down.edges_count());
+}
+
+
+bool load_hierarchy_cached(std::string hierarchy_file, const AdjacencyMatrix &graph, const AdjacencyMatrix &inv_graph,
+                           ContractionHierarchy &hierarchy, bool *built, const ContractionOptions &options) {
+    if (built != nullptr) {
+        *built = false;
+    }
+    if (hierarchy.load(hierarchy_file, graph) == true) {
+        return true;
+    }
+
+    hierarchy = ContractionHierarchy(graph, inv_graph, options);
+    if (built != nullptr) {
+        *built = true;
+    }
+    return hierarchy.save(hierarchy_file);
+}
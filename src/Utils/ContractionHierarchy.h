@@ -0,0 +1,89 @@
+#ifndef UTILS_CONTRACTION_HIERARCHY_H
+#define UTILS_CONTRACTION_HIERARCHY_H
+
+#include <vector>
+#include <memory>
+#include <string>
+#include <cstdint>
+#include <limits>
+#include "Definitions.h"
+
+struct ContractionOptions {
+    // Contraction stops once the remaining vertices have this many edges per vertex on average,
+    // bi-objective shortcuts multiply quickly in the dense upper part of the hierarchy
+    double      core_degree             = 12;
+    // Labels a witness search settles before giving up, in which case the shortcut is kept
+    size_t      witness_settled_limit   = 1000;
+};
+
+// Graph of a single query on a contraction hierarchy, holding only the vertices reached from the source
+// upwards and from the target downwards. They are numbered from 1 in the order they were reached.
+struct QueryGraph {
+    AdjacencyMatrix         graph;
+    AdjacencyMatrix         inv_graph;
+    // Hierarchy vertex of each query graph vertex, vertices[0] is unused
+    std::vector<uint32_t>   vertices;
+    size_t                  source  = 0;
+    size_t                  target  = 0;
+};
+
+// Bi-objective contraction hierarchy. Vertices are contracted one at a time by their edge difference,
+// and contracting v adds a shortcut u->w for each pair of edges u->v->w unless a witness path from u
+// to w avoiding v weakly dominates both its costs. Shortcuts are kept per Pareto necessary cost pair,
+// so two vertices may be joined by several parallel edges. Every Pareto optimal cost of the graph is
+// then the cost of a path going only up the contraction order and then only down. The vertices left
+// once the contraction stops form the core, whose edges are all kept as upward edges.
+// Built once per graph and saved to disk, where it is memory mapped on load.
+class ContractionHierarchy {
+public:
+    // Via vertex of the original edges
+    static const uint32_t       NO_VIA = std::numeric_limits<uint32_t>::max();
+
+private:
+    // Edges of the graph the hierarchy was built for
+    size_t                      graph_edges     = 0;
+    uint64_t                    graph_checksum  = 0;
+    size_t                      core_amount     = 0;
+    // Edges to vertices contracted later and core edges
+    AdjacencyMatrix             up;
+    // Edges from vertices contracted later, stored at their head pointing to their tail
+    AdjacencyMatrix             inv_down;
+    // Vertex a shortcut was added for, per edge of up and inv_down
+    const uint32_t              *up_via         = nullptr;
+    const uint32_t              *inv_down_via   = nullptr;
+    std::shared_ptr<const void> storage;
+
+    uint32_t find_via(size_t source, size_t target, const Pair<size_t> &cost) const;
+
+public:
+    ContractionHierarchy() = default;
+    ContractionHierarchy(const AdjacencyMatrix &graph, const AdjacencyMatrix &inv_graph,
+                         const ContractionOptions &options=ContractionOptions());
+
+    size_t size(void) const {return this->up.size();}
+    size_t core_size(void) const {return this->core_amount;}
+    // Edges of the hierarchy, original edges and shortcuts
+    size_t edges_count(void) const {return this->up.edges_count() + this->inv_down.edges_count();}
+
+    // Graph of a single query holding the upward search space of source and the downward search
+    // space of target. Its paths from source to target cover all the Pareto optimal costs of the graph.
+    // Its size is that of the search spaces and not of the graph.
+    void build_query_graph(size_t source, size_t target, QueryGraph &query_graph) const;
+    // Appends the vertices of the edge source->target with the given cost, without source itself.
+    // Shortcuts are replaced by the original edges they stand for.
+    void unpack_edge(size_t source, size_t target, const Pair<size_t> &cost, std::vector<uint32_t> &vertices) const;
+
+    bool save(std::string hierarchy_file) const;
+    // Memory maps the hierarchy, failing if it was built for another graph
+    bool load(std::string hierarchy_file, const AdjacencyMatrix &graph);
+    // Size of the hierarchy on disk and in memory
+    size_t memory_bytes(void) const;
+};
+
+// Loads the hierarchy, building and saving it first if it can't be loaded.
+// built is set when the hierarchy was computed.
+bool load_hierarchy_cached(std::string hierarchy_file, const AdjacencyMatrix &graph, const AdjacencyMatrix &inv_graph,
+                           ContractionHierarchy &hierarchy, bool *built=nullptr,
+                           const ContractionOptions &options=ContractionOptions());
+
+#endif //UTILS_CONTRACTION_HIERARCHY_H
@@ -9,6 +9,10 @@
 #include <limits>
 #include <functional>
 #include <memory>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include "Arena.h"
 
 
 #ifndef DEBUG
@@ -19,92 +23,393 @@
 const size_t MAX_COST = std::numeric_limits<size_t>::max();
 
 
-template<typename T>
-using Pair      = std::array<T, 2>;
+// Costs of N objectives, Pair is the bi-objective case
+template<typename T, size_t N>
+using Costs     = std::array<T, N>;
 
 template<typename T>
-std::ostream& operator<<(std::ostream &stream, const Pair<T> pair) {
-    stream << "[" << pair[0] << ", " << pair[1] << "]";
+using Pair      = Costs<T, 2>;
+
+template<typename T, size_t N>
+std::ostream& operator<<(std::ostream &stream, const Costs<T, N> &costs) {
+    stream << "[";
+    for (size_t i = 0; i < N; i++) {
+        stream << (i == 0 ? "" : ", ") << costs[i];
+    }
+    stream << "]";
     return stream;
 }
 
 
 using Heuristic = std::function<Pair<size_t>(size_t)>;
 
+// Heuristics computed from shortest paths may also provide dominant_path_next(cost_idx, node_id),
+// the next vertex on a path to their root that is shortest for both costs, or NO_PATH
+const size_t NO_PATH = std::numeric_limits<size_t>::max();
 
-// Structs and classes
-struct Edge {
-    size_t          source;
-    size_t          target;
-    Pair<size_t>    cost;
 
-    Edge(size_t source, size_t target, Pair<size_t> cost) : source(source), target(target), cost(cost) {}
-    Edge inverse() {
-        return Edge(this->target, this->source, this->cost);
+// Structs and classes
+template<size_t N>
+struct BasicEdge {
+    size_t              source;
+    size_t              target;
+    Costs<size_t, N>    cost;
+
+    BasicEdge(size_t source, size_t target, Costs<size_t, N> cost) : source(source), target(target), cost(cost) {}
+    BasicEdge inverse() {
+        return BasicEdge(this->target, this->source, this->cost);
     }
 };
-std::ostream& operator<<(std::ostream &stream, const Edge &edge);
 
+template<size_t N>
+std::ostream& operator<<(std::ostream &stream, const BasicEdge<N> &edge) {
+    // Printed in JSON format
+    stream
+        << "{"
+        <<  "\"edge_source\": " << edge.source << ", "
+        <<  "\"edge_target\": " << edge.target << ", "
+        <<  "\"edge_cost\": " << edge.cost
+        << "}";
+
+    return stream;
+}
+
+using Edge = BasicEdge<2>;
+
+
+// Edge costs are stored with 32 bits in the graph, which is enough for all the DIMACS road maps
+using EdgeCost = uint32_t;
+const size_t MAX_EDGE_COST = std::numeric_limits<EdgeCost>::max();
 
-// Graph representation as adjacency matrix
-class AdjacencyMatrix {
+
+// Graph representation as compressed sparse row adjacency matrix. The outgoing edges of
+// each vertex are stored contiguously, with targets and each cost kept in separate columns.
+// The columns are immutable and may live in memory owned elsewhere (e.g. a memory mapped
+// graph cache), so copies of the graph share them.
+template<size_t N>
+class BasicAdjacencyMatrix {
 private:
-    std::vector<std::vector<Edge>> matrix;
-    size_t                         graph_size;
+    struct Columns {
+        std::vector<uint32_t>               offsets;
+        std::vector<uint32_t>               targets;
+        Costs<std::vector<EdgeCost>, N>     costs;
+
+        void set_edge(size_t edge_idx, size_t target, const Costs<size_t, N> &cost);
+    };
+
+    size_t                          graph_size  = 0;
+    size_t                          edges_amount = 0;
+    const uint32_t                  *offsets    = nullptr;
+    const uint32_t                  *targets    = nullptr;
+    Costs<const EdgeCost*, N>       costs       = {};
+    std::shared_ptr<const void>     storage;
+
+    Columns &allocate(size_t graph_size, size_t edges_count);
 
 public:
-    AdjacencyMatrix() = default;
-    AdjacencyMatrix(size_t graph_size, std::vector<Edge> &edges, bool inverse=false);
-    void add(Edge edge);
-    size_t size(void) const;
-    const std::vector<Edge>& operator[](size_t vertex_id) const;
+    // View over the outgoing edges of a single vertex
+    struct OutgoingEdges {
+        size_t                      size;
+        const uint32_t              *target;
+        Costs<const EdgeCost*, N>   cost;
+    };
 
-    friend std::ostream& operator<<(std::ostream &stream, const AdjacencyMatrix &adj_matrix);
+    BasicAdjacencyMatrix() = default;
+    BasicAdjacencyMatrix(size_t graph_size, const std::vector<BasicEdge<N>> &edges, bool inverse=false);
+    // Wraps existing CSR columns without copying, storage keeps the underlying memory alive.
+    // offsets must hold graph_size+2 entries.
+    BasicAdjacencyMatrix(size_t graph_size, size_t edges_count,
+                         const uint32_t *offsets, const uint32_t *targets, Costs<const EdgeCost*, N> costs,
+                         std::shared_ptr<const void> storage);
+    size_t size(void) const {return this->graph_size;}
+    size_t edges_count(void) const {return this->edges_amount;}
+
+    OutgoingEdges operator[](size_t vertex_id) const {
+        size_t first = this->offsets[vertex_id];
+        OutgoingEdges outgoing_edges = {this->offsets[vertex_id+1] - first, this->targets + first, {}};
+        for (size_t cost_idx = 0; cost_idx < N; cost_idx++) {
+            outgoing_edges.cost[cost_idx] = this->costs[cost_idx] + first;
+        }
+        return outgoing_edges;
+    }
+
+    // Raw columns, used for serialization
+    const uint32_t *get_offsets(void) const {return this->offsets;}
+    const uint32_t *get_targets(void) const {return this->targets;}
+    const EdgeCost *get_costs(size_t cost_idx) const {return this->costs[cost_idx];}
+
+    // Checks that the offsets start at 0, never decrease and end at edges_count, and that every target
+    // is a vertex of the graph. Used on columns read from disk before searching them.
+    bool is_valid(void) const;
+    // FNV-1a style hash over the values of all the columns, ties files derived from the graph to its contents
+    uint64_t checksum(void) const;
+
+    // Builds the graph and its inverse together, scanning the edge list once for both
+    static void build_with_inverse(size_t graph_size, const std::vector<BasicEdge<N>> &edges,
+                                   BasicAdjacencyMatrix &graph, BasicAdjacencyMatrix &inv_graph);
 };
 
+template<size_t N>
+BasicAdjacencyMatrix<N>::BasicAdjacencyMatrix(size_t graph_size, const std::vector<BasicEdge<N>> &edges, bool inverse) {
+    Columns &columns = this->allocate(graph_size, edges.size());
 
-struct Node;
-struct PathPair;
-using NodePtr       = std::shared_ptr<Node>;
-using PathPairPtr   = std::shared_ptr<PathPair>;
-using SolutionSet   = std::vector<NodePtr>;
-using PPSolutionSet = std::vector<PathPairPtr>;
+    // Count the outgoing edges per vertex, offsets[v+1] ends up holding the first edge of v
+    for (auto iter = edges.begin(); iter != edges.end(); ++iter) {
+        columns.offsets[(inverse ? iter->target : iter->source)+2]++;
+    }
+    for (size_t i = 2; i < columns.offsets.size(); i++) {
+        columns.offsets[i] += columns.offsets[i-1];
+    }
 
+    for (auto iter = edges.begin(); iter != edges.end(); ++iter) {
+        if (inverse) {
+            columns.set_edge(columns.offsets[iter->target+1]++, iter->source, iter->cost);
+        } else {
+            columns.set_edge(columns.offsets[iter->source+1]++, iter->target, iter->cost);
+        }
+    }
+}
 
-struct Node {
-    size_t          id;
-    Pair<size_t>    g;
-    Pair<size_t>    h;
-    Pair<size_t>    f;
-    NodePtr         parent;
 
-    Node(size_t id, Pair<size_t> g, Pair<size_t> h, NodePtr parent=nullptr)
-        : id(id), g(g), h(h), f({g[0]+h[0],g[1]+h[1]}), parent(parent) {};
+template<size_t N>
+BasicAdjacencyMatrix<N>::BasicAdjacencyMatrix(size_t graph_size, size_t edges_count,
+                                              const uint32_t *offsets, const uint32_t *targets,
+                                              Costs<const EdgeCost*, N> costs, std::shared_ptr<const void> storage)
+    : graph_size(graph_size), edges_amount(edges_count), offsets(offsets), targets(targets),
+      costs(costs), storage(storage) {}
 
-    struct more_than_specific_heurisitic_cost {
-        size_t cost_idx;
 
-        more_than_specific_heurisitic_cost(size_t cost_idx) : cost_idx(cost_idx) {};
-        bool operator()(const NodePtr &a, const NodePtr &b) const;
+template<size_t N>
+void BasicAdjacencyMatrix<N>::build_with_inverse(size_t graph_size, const std::vector<BasicEdge<N>> &edges,
+                                                 BasicAdjacencyMatrix &graph, BasicAdjacencyMatrix &inv_graph) {
+    Columns &columns = graph.allocate(graph_size, edges.size());
+    Columns &inv_columns = inv_graph.allocate(graph_size, edges.size());
+
+    for (auto iter = edges.begin(); iter != edges.end(); ++iter) {
+        columns.offsets[iter->source+2]++;
+        inv_columns.offsets[iter->target+2]++;
+    }
+    for (size_t i = 2; i < columns.offsets.size(); i++) {
+        columns.offsets[i] += columns.offsets[i-1];
+        inv_columns.offsets[i] += inv_columns.offsets[i-1];
+    }
+
+    for (auto iter = edges.begin(); iter != edges.end(); ++iter) {
+        columns.set_edge(columns.offsets[iter->source+1]++, iter->target, iter->cost);
+        inv_columns.set_edge(inv_columns.offsets[iter->target+1]++, iter->source, iter->cost);
+    }
+}
+
+
+template<size_t N>
+bool BasicAdjacencyMatrix<N>::is_valid() const {
+    if ((this->offsets == nullptr) || (this->offsets[0] != 0) ||
+        (this->offsets[this->graph_size+1] != this->edges_amount)) {
+        return false;
+    }
+    for (size_t vertex_id = 0; vertex_id <= this->graph_size; vertex_id++) {
+        if (this->offsets[vertex_id] > this->offsets[vertex_id+1]) {
+            return false;
+        }
+    }
+    for (size_t edge_idx = 0; edge_idx < this->edges_amount; edge_idx++) {
+        if (this->targets[edge_idx] > this->graph_size) {
+            return false;
+        }
+    }
+    return true;
+}
+
+
+template<size_t N>
+uint64_t BasicAdjacencyMatrix<N>::checksum() const {
+    uint64_t hash = 14695981039346656037ULL;
+    auto add = [&hash](const uint32_t *values, size_t amount) {
+        for (size_t i = 0; i < amount; i++) {
+            hash = (hash ^ values[i]) * 1099511628211ULL;
+        }
     };
+    if (this->offsets != nullptr) {
+        add(this->offsets, this->graph_size+2);
+        add(this->targets, this->edges_amount);
+        for (size_t cost_idx = 0; cost_idx < N; cost_idx++) {
+            add(this->costs[cost_idx], this->edges_amount);
+        }
+    }
+    return hash;
+}
+
+
+template<size_t N>
+typename BasicAdjacencyMatrix<N>::Columns &BasicAdjacencyMatrix<N>::allocate(size_t graph_size, size_t edges_count) {
+    if ((graph_size+2 > std::numeric_limits<uint32_t>::max()) ||
+        (edges_count > std::numeric_limits<uint32_t>::max())) {
+        throw std::length_error("Graph is too large for 32 bit vertex and edge indices");
+    }
+
+    // Vertex ids are 1-based in the DIMACS files so the graph holds graph_size+1 vertices.
+    // One extra offset is used as scratch while counting.
+    std::shared_ptr<Columns> columns = std::make_shared<Columns>();
+    columns->offsets.assign(graph_size+3, 0);
+    columns->targets.resize(edges_count);
+    for (size_t cost_idx = 0; cost_idx < N; cost_idx++) {
+        columns->costs[cost_idx].resize(edges_count);
+        this->costs[cost_idx] = columns->costs[cost_idx].data();
+    }
+
+    this->graph_size = graph_size;
+    this->edges_amount = edges_count;
+    this->offsets = columns->offsets.data();
+    this->targets = columns->targets.data();
+    this->storage = columns;
+    return *columns;
+}
+
+
+template<size_t N>
+void BasicAdjacencyMatrix<N>::Columns::set_edge(size_t edge_idx, size_t target, const Costs<size_t, N> &cost) {
+    this->targets[edge_idx] = target;
+    for (size_t cost_idx = 0; cost_idx < N; cost_idx++) {
+        if (cost[cost_idx] > MAX_EDGE_COST) {
+            throw std::out_of_range("Edge cost does not fit in EdgeCost");
+        }
+        this->costs[cost_idx][edge_idx] = cost[cost_idx];
+    }
+}
+
+
+template<size_t N>
+std::ostream& operator<<(std::ostream &stream, const BasicAdjacencyMatrix<N> &adj_matrix) {
+    stream << "{\n";
+    for (size_t vertex_id = 0; vertex_id <= adj_matrix.size(); vertex_id++) {
+        stream << "\t\"" << vertex_id << "\": [";
 
+        typename BasicAdjacencyMatrix<N>::OutgoingEdges outgoing_edges = adj_matrix[vertex_id];
+        for (size_t i = 0; i < outgoing_edges.size; i++) {
+            stream << "\"" << vertex_id << "->" << outgoing_edges.target[i] << "\", ";
+        }
+
+        stream << "],\n";
+    }
+    stream << "}";
+    return stream;
+}
+
+using AdjacencyMatrix = BasicAdjacencyMatrix<2>;
+
+
+// Path costs in nodes are kept in CostT. Conversions from the size_t costs computed by the searches
+// throw if a path cost does not fit, while heuristic and full costs saturate at the maximum, which
+// keeps MAX_COST heuristics of vertices that can't reach the target meaningful.
+template<typename CostT>
+CostT to_path_cost(size_t cost) {
+    if (static_cast<CostT>(cost) != cost) {
+        throw std::overflow_error("Path cost does not fit in the node cost type");
+    }
+    return static_cast<CostT>(cost);
+}
+
+template<typename CostT>
+CostT to_saturated_cost(size_t cost) {
+    return (static_cast<CostT>(cost) != cost) ? std::numeric_limits<CostT>::max() : static_cast<CostT>(cost);
+}
+
+
+using NodeHandle    = Handle;
+
+// Nodes live in a pool owned by the search, parents are referenced by their pool handle.
+// The heuristic cost is not stored as it is f-g, and vertex ids fit in 32 bits like the graph indices,
+// which keeps the bi-objective node at 28 bytes. The costs read on every pop come first.
+template<typename CostT, size_t N>
+struct BasicNode {
+    uint32_t            id;
+    Costs<CostT, N>     g;
+    Costs<CostT, N>     f;
+    NodeHandle          handle;
+    NodeHandle          parent;
+
+    BasicNode(NodeHandle handle, size_t id, const Costs<size_t, N> &g, const Costs<size_t, N> &h,
+              NodeHandle parent=NULL_HANDLE) : id(id), handle(handle), parent(parent) {
+        for (size_t i = 0; i < N; i++) {
+            this->g[i] = to_path_cost<CostT>(g[i]);
+            this->f[i] = to_saturated_cost<CostT>((h[i] > MAX_COST-g[i]) ? MAX_COST : g[i]+h[i]);
+        }
+    }
+
+    // Heuristic cost the node was created with, saturated if the full cost was
+    Costs<CostT, N> h(void) const {
+        Costs<CostT, N> node_h;
+        for (size_t i = 0; i < N; i++) {
+            node_h[i] = this->f[i] - this->g[i];
+        }
+        return node_h;
+    }
+
+    // Lexicographic order of the full costs
     struct more_than_full_cost {
-        bool operator()(const NodePtr &a, const NodePtr &b) const;
+        bool operator()(const BasicNode *a, const BasicNode *b) const {
+            for (size_t i = 0; i+1 < N; i++) {
+                if (a->f[i] != b->f[i]) {
+                    return (a->f[i] > b->f[i]);
+                }
+            }
+            return (a->f[N-1] > b->f[N-1]);
+        }
     };
+};
+
 
-    friend std::ostream& operator<<(std::ostream &stream, const Node &node);
+// Printing a node requires its pool in order to resolve the parent handle to a vertex id
+template<typename NodeT>
+struct BasicPooledNode {
+    const NodeT         &node;
+    const Arena<NodeT>  &pool;
 };
 
+template<typename NodeT>
+std::ostream& operator<<(std::ostream &stream, const BasicPooledNode<NodeT> &pooled_node) {
+    // Printed in JSON format
+    const NodeT &node = pooled_node.node;
+    std::string parent_id = node.parent == NULL_HANDLE ? "-1" : std::to_string(pooled_node.pool[node.parent].id);
+    stream
+        << "{"
+        <<      "\"id\": " << node.id << ", "
+        <<      "\"parent\": " << parent_id << ", "
+        <<      "\"cost_until_now\": " << node.g << ", "
+        <<      "\"heuristic_cost\": " << node.h() << ", "
+        <<      "\"full_cost\": " << node.f
+        << "}";
+    return stream;
+}
+
+
+// The bi-objective searches keep 32 bit path costs, which is enough for all the DIMACS road maps
+using NodeCost      = uint32_t;
+using Node          = BasicNode<NodeCost, 2>;
+using PooledNode    = BasicPooledNode<Node>;
+
+struct PathPair;
+using NodePtr       = Node*;
+using PathPairPtr   = PathPair*;
+using NodePool      = Arena<Node>;
+using PathPairPool  = Arena<PathPair>;
+using SolutionSet   = std::vector<NodePtr>;
+using PPSolutionSet = std::vector<PathPairPtr>;
+
 
 struct PathPair {
-    size_t      id;
+    Handle      handle;
+    uint32_t    id;
     NodePtr     top_left;
     NodePtr     bottom_right;
-    NodePtr     parent;
-    bool        is_active=true;
 
-    PathPair(const NodePtr &top_left, const NodePtr &bottom_right)
-        : id(top_left->id), top_left(top_left), bottom_right(bottom_right), parent(top_left->parent) {};
+    // Position in PPQueue heap and links of the open path pairs list of the vertex
+    PathPairPtr prev_open   = nullptr;
+    PathPairPtr next_open   = nullptr;
+    uint32_t    heap_idx    = 0;
+
+    PathPair(Handle handle, const NodePtr &top_left, const NodePtr &bottom_right)
+        : handle(handle), id(top_left->id), top_left(top_left), bottom_right(bottom_right) {};
 
     bool update_nodes_by_merge_if_bounded(const PathPairPtr &other, const Pair<double> eps);
 
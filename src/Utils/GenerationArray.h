@@ -0,0 +1,55 @@
+#ifndef UTILS_GENERATION_ARRAY_H
+#define UTILS_GENERATION_ARRAY_H
+
+#include <vector>
+#include <cstdint>
+
+// Array whose entries are reset to a default value in O(1) by bumping a generation counter.
+// An entry holds a value only if it was written during the current generation.
+template<typename T>
+class GenerationArray {
+private:
+    struct Entry {
+        T           value;
+        uint32_t    generation;
+    };
+
+    std::vector<Entry>  entries;
+    uint32_t            generation = 1;
+    T                   default_value;
+
+public:
+    GenerationArray(T default_value) : default_value(default_value) {}
+
+    // Resets all entries to the default value, growing the array to at least size entries
+    void reset(size_t size) {
+        if (size > this->entries.size()) {
+            this->entries.resize(size, {this->default_value, 0});
+        }
+        if (++this->generation == 0) {
+            // Generation counter wrapped around, stale entries must be cleared for real
+            for (auto entry = this->entries.begin(); entry != this->entries.end(); ++entry) {
+                entry->generation = 0;
+            }
+            this->generation = 1;
+        }
+    }
+
+    T get(size_t idx) const {
+        const Entry &entry = this->entries[idx];
+        return entry.generation == this->generation ? entry.value : this->default_value;
+    }
+
+    void set(size_t idx, T value) {
+        this->entries[idx] = {value, this->generation};
+    }
+
+    size_t size(void) const {return this->entries.size();}
+
+    // Frees the entries, the next reset() allocates them again
+    void release(void) {
+        std::vector<Entry>().swap(this->entries);
+    }
+};
+
+#endif //UTILS_GENERATION_ARRAY_H
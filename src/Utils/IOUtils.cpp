@@ -2,7 +2,37 @@
 #include <vector>
 #include <fstream>
 #include <algorithm>
+#include <memory>
+#include <chrono>
+#include <thread>
+#include <functional>
+#include <limits>
+#include <sys/stat.h>
 #include "IOUtils.h"
+#include "MappedFile.h"
+
+// Graph cache file layout. All integers are stored in native byte order, which is validated
+// on load using byte_order_mark. Both graphs are stored as CSR columns of uint32 values:
+//     GraphCacheHeader
+//     graph:      offsets[graph_size+2], targets[edges_count], costs0[edges_count], costs1[edges_count]
+//     inv_graph:  offsets[graph_size+2], targets[edges_count], costs0[edges_count], costs1[edges_count]
+// The size and modification time of the files the graph was parsed from tie the cache to them,
+// unused source slots are zero.
+const char      GRAPH_CACHE_MAGIC[8]        = {'P','P','A','G','R','A','P','H'};
+const uint32_t  GRAPH_CACHE_VERSION         = 2;
+const uint32_t  GRAPH_CACHE_BYTE_ORDER_MARK = 0x01020304;
+const size_t    GRAPH_CACHE_MAX_SOURCES     = 2;
+
+struct GraphCacheHeader {
+    char        magic[8];
+    uint32_t    version;
+    uint32_t    byte_order_mark;
+    uint64_t    graph_size;
+    uint64_t    edges_count;
+    uint64_t    source_sizes[GRAPH_CACHE_MAX_SOURCES];
+    int64_t     source_mtimes[GRAPH_CACHE_MAX_SOURCES];
+};
+
 
 void split_string(std::string string, std::string delimiter, std::vector<std::string> &results)
 {
@@ -21,83 +51,292 @@ void split_string(std::string string, std::string delimiter, std::vector<std::st
 }
 
 
-bool load_gr_files(std::string gr_file1, std::string gr_file2, std::vector<Edge> &edges_out, size_t &graph_size) {
-    size_t          max_node_num = 0;
-    std::ifstream   file1(gr_file1.c_str());
-    std::ifstream   file2(gr_file2.c_str());
+// Hand rolled parsing of an unsigned decimal integer, skipping leading blanks.
+// Returns false if no digits were found or the value does not fit in a size_t.
+inline bool parse_unsigned(const char *&pos, const char *end, size_t &value) {
+    while ((pos != end) && ((*pos == ' ') || (*pos == '\t'))) {
+        ++pos;
+    }
 
-    if ((file1.is_open() == false) || (file2.is_open() == false)) {
-        return false;
+    const char *first_digit = pos;
+    value = 0;
+    while ((pos != end) && (static_cast<unsigned char>(*pos - '0') < 10)) {
+        size_t digit = *pos - '0';
+        if (value > (std::numeric_limits<size_t>::max() - digit) / 10) {
+            return false;
+        }
+        value = value*10 + digit;
+        ++pos;
     }
+    return pos != first_digit;
+}
 
-    std::string line1, line2;
-    while ((file1.eof() == false) && (file2.eof() == false)) {
-        std::getline(file1, line1);
-        std::getline(file2, line2);
 
-        if ((line1 == "") || (line2 == "")) {
-            break;
+inline void skip_line(const char *&pos, const char *end) {
+    const char *newline = static_cast<const char*>(std::memchr(pos, '\n', end - pos));
+    pos = (newline == nullptr) ? end : newline + 1;
+}
+
+
+struct TextChunk {
+    const char  *begin;
+    const char  *end;
+};
+
+
+// Splits the buffer into about chunks_amount chunks, each ending on a line boundary
+std::vector<TextChunk> split_to_chunks(const char *data, size_t size, size_t chunks_amount) {
+    std::vector<TextChunk> chunks;
+    const char *end = data + size;
+    const char *pos = data;
+    size_t chunk_size = size / chunks_amount + 1;
+
+    while (pos != end) {
+        const char *chunk_end = (size_t(end - pos) <= chunk_size) ? end : pos + chunk_size;
+        skip_line(chunk_end, end);
+        chunks.push_back({pos, chunk_end});
+        pos = chunk_end;
+    }
+    return chunks;
+}
+
+
+size_t parser_threads_amount(size_t bytes) {
+    // Below a few MB per thread the thread startup costs more than it saves
+    const size_t min_bytes_per_thread = 4 << 20;
+    size_t hardware_threads = std::max<size_t>(1, std::thread::hardware_concurrency());
+    return std::max<size_t>(1, std::min(hardware_threads, bytes / min_bytes_per_thread));
+}
+
+
+// Runs parse_chunk(chunk_idx) for every chunk over a fixed amount of threads.
+// Returns false if parsing any of the chunks failed.
+bool parse_chunks_in_parallel(size_t chunks_amount, size_t threads_amount,
+                              const std::function<bool(size_t)> &parse_chunk) {
+    std::vector<char> chunk_results(chunks_amount, false);
+    auto worker = [&](size_t first_chunk) {
+        for (size_t chunk_idx = first_chunk; chunk_idx < chunks_amount; chunk_idx += threads_amount) {
+            chunk_results[chunk_idx] = parse_chunk(chunk_idx);
         }
+    };
+
+    std::vector<std::thread> threads;
+    for (size_t i = 1; i < threads_amount; i++) {
+        threads.emplace_back(worker, i);
+    }
+    worker(0);
+    for (auto thread = threads.begin(); thread != threads.end(); ++thread) {
+        thread->join();
+    }
+
+    return std::find(chunk_results.begin(), chunk_results.end(), false) == chunk_results.end();
+}
 
-        std::vector<std::string> decomposed_line1, decomposed_line2;
-        split_string(line1, " ", decomposed_line1);
-        split_string(line2, " ", decomposed_line2);
 
-        std::string type = decomposed_line1[0];
-        if ((std::strcmp(type.c_str(),"c") == 0) || (std::strcmp(type.c_str(),"p") == 0)) {
-            continue; //comment or problem lines, not part of the graph
+struct GrArc {
+    size_t  source;
+    size_t  target;
+    size_t  cost;
+};
+
+
+// Parses the arc lines of a DIMACS gr chunk, comment and problem lines are skipped
+bool parse_gr_chunk(const TextChunk &chunk, std::vector<GrArc> &arcs_out) {
+    const char *pos = chunk.begin;
+    while (pos != chunk.end) {
+        if (*pos == 'a') {
+            GrArc arc;
+            ++pos;
+            if ((parse_unsigned(pos, chunk.end, arc.source) == false) ||
+                (parse_unsigned(pos, chunk.end, arc.target) == false) ||
+                (parse_unsigned(pos, chunk.end, arc.cost) == false)) {
+                return false;
+            }
+            arcs_out.push_back(arc);
+        } else if ((*pos != 'c') && (*pos != 'p') && (*pos != '\n') && (*pos != '\r')) {
+            return false;
         }
+        skip_line(pos, chunk.end);
+    }
+    return true;
+}
+
+
+double LoadStats::throughput_mb_per_sec() const {
+    return this->seconds > 0 ? (this->bytes / (1024.0*1024.0)) / this->seconds : 0;
+}
+
+
+// Advances to the next arc of the chunked arcs, returning nullptr past the last one
+const GrArc *next_arc(const std::vector<std::vector<GrArc>> &arcs, size_t &chunk_idx, size_t &arc_idx) {
+    while ((chunk_idx < arcs.size()) && (arc_idx == arcs[chunk_idx].size())) {
+        chunk_idx++;
+        arc_idx = 0;
+    }
+    return (chunk_idx == arcs.size()) ? nullptr : &arcs[chunk_idx][arc_idx++];
+}
+
+
+template<size_t N>
+bool load_gr_files(const Costs<std::string, N> &gr_files, std::vector<BasicEdge<N>> &edges_out, size_t &graph_size,
+                   LoadStats *stats) {
+    auto start_time = std::chrono::steady_clock::now();
 
-        if ((decomposed_line1[0] != decomposed_line2[0]) ||
-            (decomposed_line1[1] != decomposed_line2[1]) ||
-            (decomposed_line1[2] != decomposed_line2[2])) {
-            // arc_sign src dest should be same in both files
+    std::array<MappedFile, N> files;
+    size_t total_bytes = 0;
+    for (size_t file_idx = 0; file_idx < N; file_idx++) {
+        if (files[file_idx].open(gr_files[file_idx]) == false) {
             return false;
         }
+        total_bytes += files[file_idx].size();
+    }
 
-        if (std::strcmp(type.c_str(),"a") == 0) { //arc
-            Edge e(std::stoul(decomposed_line1[1]),
-                   std::stoul(decomposed_line1[2]),
-                   {std::stoul(decomposed_line1[3]), std::stoul(decomposed_line2[3])});
-            edges_out.push_back(e);
-            max_node_num = std::max({max_node_num, e.source, e.target});
+    // All files are split and parsed independently, the arcs are matched by their order afterwards
+    size_t threads_amount = parser_threads_amount(total_bytes);
+    std::array<std::vector<TextChunk>, N> chunks;
+    std::array<std::vector<std::vector<GrArc>>, N> arcs;
+    std::vector<std::pair<size_t, size_t>> jobs;
+    for (size_t file_idx = 0; file_idx < N; file_idx++) {
+        chunks[file_idx] = split_to_chunks(files[file_idx].data(), files[file_idx].size(), threads_amount);
+        arcs[file_idx].resize(chunks[file_idx].size());
+        for (size_t chunk_idx = 0; chunk_idx < chunks[file_idx].size(); chunk_idx++) {
+            jobs.emplace_back(file_idx, chunk_idx);
         }
     }
+
+    bool parsed = parse_chunks_in_parallel(jobs.size(), threads_amount, [&](size_t job_idx) {
+        size_t file_idx = jobs[job_idx].first;
+        size_t chunk_idx = jobs[job_idx].second;
+        return parse_gr_chunk(chunks[file_idx][chunk_idx], arcs[file_idx][chunk_idx]);
+    });
+    if (parsed == false) {
+        return false;
+    }
+
+    // Merge into the edge list while checking that src and dest are the same in all files
+    size_t max_node_num = 0;
+    size_t arcs_amount = 0;
+    for (auto chunk_arcs = arcs[0].begin(); chunk_arcs != arcs[0].end(); ++chunk_arcs) {
+        arcs_amount += chunk_arcs->size();
+    }
+    edges_out.reserve(edges_out.size() + arcs_amount);
+
+    Costs<size_t, N> chunk_idx = {};
+    Costs<size_t, N> arc_idx = {};
+    const GrArc *arc;
+    while ((arc = next_arc(arcs[0], chunk_idx[0], arc_idx[0])) != nullptr) {
+        Costs<size_t, N> cost;
+        cost[0] = arc->cost;
+        for (size_t file_idx = 1; file_idx < N; file_idx++) {
+            const GrArc *other_arc = next_arc(arcs[file_idx], chunk_idx[file_idx], arc_idx[file_idx]);
+            if (other_arc == nullptr) {
+                return false; // First file has more arcs than this one
+            }
+            if ((arc->source != other_arc->source) || (arc->target != other_arc->target)) {
+                return false;
+            }
+            cost[file_idx] = other_arc->cost;
+        }
+
+        edges_out.emplace_back(arc->source, arc->target, cost);
+        max_node_num = std::max({max_node_num, arc->source, arc->target});
+    }
+    for (size_t file_idx = 1; file_idx < N; file_idx++) {
+        if (next_arc(arcs[file_idx], chunk_idx[file_idx], arc_idx[file_idx]) != nullptr) {
+            return false; // This file has more arcs than the first one
+        }
+    }
+
     graph_size = max_node_num;
+
+    if (stats != nullptr) {
+        stats->bytes = total_bytes;
+        stats->threads = threads_amount;
+        stats->seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+    }
     return true;
 }
 
-bool load_txt_file(std::string txt_file, std::vector<Edge> &edges_out, size_t &graph_size) {
-    bool            first_line = true;
-    size_t          max_node_num = 0;
-    std::ifstream   file(txt_file.c_str());
+template bool load_gr_files<2>(const Costs<std::string, 2>&, std::vector<BasicEdge<2>>&, size_t&, LoadStats*);
+template bool load_gr_files<3>(const Costs<std::string, 3>&, std::vector<BasicEdge<3>>&, size_t&, LoadStats*);
+template bool load_gr_files<4>(const Costs<std::string, 4>&, std::vector<BasicEdge<4>>&, size_t&, LoadStats*);
 
-    if (file.is_open() == false) {
+
+bool load_gr_files(std::string gr_file1, std::string gr_file2, std::vector<Edge> &edges_out, size_t &graph_size,
+                   LoadStats *stats) {
+    return load_gr_files<2>({gr_file1, gr_file2}, edges_out, graph_size, stats);
+}
+
+
+// Parses "source target cost1 cost2" lines of a txt graph chunk
+bool parse_txt_chunk(const TextChunk &chunk, std::vector<Edge> &edges_out, size_t &max_node_num) {
+    const char *pos = chunk.begin;
+    while (pos != chunk.end) {
+        if ((*pos == '\n') || (*pos == '\r')) {
+            skip_line(pos, chunk.end);
+            continue;
+        }
+
+        size_t source, target, cost1, cost2;
+        if ((parse_unsigned(pos, chunk.end, source) == false) ||
+            (parse_unsigned(pos, chunk.end, target) == false) ||
+            (parse_unsigned(pos, chunk.end, cost1) == false) ||
+            (parse_unsigned(pos, chunk.end, cost2) == false)) {
+            return false;
+        }
+        edges_out.emplace_back(source, target, Pair<size_t>({cost1, cost2}));
+        max_node_num = std::max({max_node_num, source, target});
+        skip_line(pos, chunk.end);
+    }
+    return true;
+}
+
+
+bool load_txt_file(std::string txt_file, std::vector<Edge> &edges_out, size_t &graph_size, LoadStats *stats) {
+    auto start_time = std::chrono::steady_clock::now();
+
+    MappedFile file;
+    if (file.open(txt_file) == false) {
         return false;
     }
 
-    std::string line;
-    while (file.eof() == false) {
-        std::getline(file, line);
+    // First line is a header and not part of the graph
+    const char *data = file.data();
+    const char *end = data + file.size();
+    if (data != end) {
+        skip_line(data, end);
+    }
 
-        if (line == "") {
-            break;
-        }
+    size_t threads_amount = parser_threads_amount(file.size());
+    std::vector<TextChunk> chunks = split_to_chunks(data, end - data, threads_amount);
+    std::vector<std::vector<Edge>> chunk_edges(chunks.size());
+    std::vector<size_t> chunk_max_node_num(chunks.size(), 0);
 
-        std::vector<std::string> decomposed_line;
-        split_string(line, " ", decomposed_line);
+    bool parsed = parse_chunks_in_parallel(chunks.size(), threads_amount, [&](size_t chunk_idx) {
+        return parse_txt_chunk(chunks[chunk_idx], chunk_edges[chunk_idx], chunk_max_node_num[chunk_idx]);
+    });
+    if (parsed == false) {
+        return false;
+    }
 
-        if (first_line) {
-            first_line = false;
-            continue;
-        }
-        Edge e(std::stoul(decomposed_line[0]),
-               std::stoul(decomposed_line[1]),
-               {std::stoul(decomposed_line[2]), std::stoul(decomposed_line[3])});
-        edges_out.push_back(e);
-        max_node_num = std::max({max_node_num, e.source, e.target});
+    size_t edges_amount = 0;
+    for (auto edges = chunk_edges.begin(); edges != chunk_edges.end(); ++edges) {
+        edges_amount += edges->size();
+    }
+    edges_out.reserve(edges_out.size() + edges_amount);
+    for (auto edges = chunk_edges.begin(); edges != chunk_edges.end(); ++edges) {
+        edges_out.insert(edges_out.end(), edges->begin(), edges->end());
+    }
+    graph_size = 0;
+    for (auto max_node_num = chunk_max_node_num.begin(); max_node_num != chunk_max_node_num.end(); ++max_node_num) {
+        graph_size = std::max(graph_size, *max_node_num);
+    }
+
+    if (stats != nullptr) {
+        stats->bytes = file.size();
+        stats->threads = threads_amount;
+        stats->seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
     }
-    graph_size = max_node_num;
     return true;
 }
 
@@ -126,4 +365,197 @@ bool load_queries(std::string query_file, std::vector<std::pair<size_t, size_t>>
         queries_out.push_back(query);
     }
     return true;
-}
\ No newline at end of file
+}
+
+
+bool load_co_file(std::string co_file, std::vector<std::pair<size_t, Pair<int64_t>>> &coordinates_out) {
+    MappedFile file;
+    if (file.open(co_file) == false) {
+        return false;
+    }
+
+    // Vertex lines are "v id x y", coordinates may be negative
+    const char *pos = file.data();
+    const char *end = pos + file.size();
+    while (pos != end) {
+        if (*pos == 'v') {
+            ++pos;
+            size_t vertex_id;
+            Pair<int64_t> coordinates;
+            if (parse_unsigned(pos, end, vertex_id) == false) {
+                return false;
+            }
+            for (size_t i = 0; i < 2; i++) {
+                while ((pos != end) && ((*pos == ' ') || (*pos == '\t'))) {
+                    ++pos;
+                }
+                bool negative = (pos != end) && (*pos == '-');
+                pos += negative ? 1 : 0;
+                size_t value;
+                if (parse_unsigned(pos, end, value) == false) {
+                    return false;
+                }
+                coordinates[i] = negative ? -int64_t(value) : int64_t(value);
+            }
+            coordinates_out.emplace_back(vertex_id, coordinates);
+        } else if ((*pos != 'c') && (*pos != 'p') && (*pos != '\n') && (*pos != '\r')) {
+            return false;
+        }
+        skip_line(pos, end);
+    }
+    return true;
+}
+
+
+size_t graph_cache_columns_size(uint64_t graph_size, uint64_t edges_count) {
+    return ((graph_size+2) + 3*edges_count) * sizeof(uint32_t);
+}
+
+
+void write_graph_columns(std::ofstream &file, const AdjacencyMatrix &graph) {
+    file.write(reinterpret_cast<const char*>(graph.get_offsets()), (graph.size()+2)*sizeof(uint32_t));
+    file.write(reinterpret_cast<const char*>(graph.get_targets()), graph.edges_count()*sizeof(uint32_t));
+    file.write(reinterpret_cast<const char*>(graph.get_costs(0)), graph.edges_count()*sizeof(EdgeCost));
+    file.write(reinterpret_cast<const char*>(graph.get_costs(1)), graph.edges_count()*sizeof(EdgeCost));
+}
+
+
+AdjacencyMatrix read_graph_columns(const char *data, const GraphCacheHeader &header,
+                                   const std::shared_ptr<const void> &storage) {
+    const uint32_t *offsets = reinterpret_cast<const uint32_t*>(data);
+    const uint32_t *targets = offsets + (header.graph_size+2);
+    const EdgeCost *costs0 = reinterpret_cast<const EdgeCost*>(targets + header.edges_count);
+    const EdgeCost *costs1 = costs0 + header.edges_count;
+    return AdjacencyMatrix(header.graph_size, header.edges_count, offsets, targets, {costs0, costs1}, storage);
+}
+
+
+// Fills the source slots of the header, failing if a source file can't be found
+bool set_graph_cache_sources(const std::vector<std::string> &source_files, GraphCacheHeader &header) {
+    if (source_files.size() > GRAPH_CACHE_MAX_SOURCES) {
+        return false;
+    }
+    for (size_t source_idx = 0; source_idx < GRAPH_CACHE_MAX_SOURCES; source_idx++) {
+        header.source_sizes[source_idx] = 0;
+        header.source_mtimes[source_idx] = 0;
+        if (source_idx < source_files.size()) {
+            struct stat file_stat;
+            if (stat(source_files[source_idx].c_str(), &file_stat) != 0) {
+                return false;
+            }
+            header.source_sizes[source_idx] = file_stat.st_size;
+            header.source_mtimes[source_idx] = file_stat.st_mtime;
+        }
+    }
+    return true;
+}
+
+
+bool save_graph_cache(std::string cache_file, const AdjacencyMatrix &graph, const AdjacencyMatrix &inv_graph,
+                      const std::vector<std::string> &source_files) {
+    if ((graph.size() != inv_graph.size()) || (graph.edges_count() != inv_graph.edges_count())) {
+        return false;
+    }
+
+    GraphCacheHeader header;
+    std::copy(GRAPH_CACHE_MAGIC, GRAPH_CACHE_MAGIC+sizeof(header.magic), header.magic);
+    header.version = GRAPH_CACHE_VERSION;
+    header.byte_order_mark = GRAPH_CACHE_BYTE_ORDER_MARK;
+    header.graph_size = graph.size();
+    header.edges_count = graph.edges_count();
+    if (set_graph_cache_sources(source_files, header) == false) {
+        return false;
+    }
+
+    std::ofstream file(cache_file.c_str(), std::ofstream::out | std::ofstream::binary | std::ofstream::trunc);
+    if (file.is_open() == false) {
+        return false;
+    }
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    write_graph_columns(file, graph);
+    write_graph_columns(file, inv_graph);
+    return file.good();
+}
+
+
+bool load_graph_cache(std::string cache_file, AdjacencyMatrix &graph, AdjacencyMatrix &inv_graph,
+                      const std::vector<std::string> &source_files) {
+    std::shared_ptr<MappedFile> file = std::make_shared<MappedFile>();
+    if ((file->open(cache_file) == false) || (file->size() < sizeof(GraphCacheHeader))) {
+        return false;
+    }
+
+    const GraphCacheHeader &header = *reinterpret_cast<const GraphCacheHeader*>(file->data());
+    if ((std::equal(GRAPH_CACHE_MAGIC, GRAPH_CACHE_MAGIC+sizeof(header.magic), header.magic) == false) ||
+        (header.version != GRAPH_CACHE_VERSION) ||
+        (header.byte_order_mark != GRAPH_CACHE_BYTE_ORDER_MARK)) {
+        return false;
+    }
+
+    if (source_files.empty() == false) {
+        GraphCacheHeader sources_header;
+        if ((set_graph_cache_sources(source_files, sources_header) == false) ||
+            (std::equal(header.source_sizes, header.source_sizes+GRAPH_CACHE_MAX_SOURCES,
+                        sources_header.source_sizes) == false) ||
+            (std::equal(header.source_mtimes, header.source_mtimes+GRAPH_CACHE_MAX_SOURCES,
+                        sources_header.source_mtimes) == false)) {
+            return false;
+        }
+    }
+
+    size_t columns_size = graph_cache_columns_size(header.graph_size, header.edges_count);
+    if (file->size() != sizeof(GraphCacheHeader) + 2*columns_size) {
+        return false;
+    }
+
+    const char *columns_data = file->data() + sizeof(GraphCacheHeader);
+    AdjacencyMatrix cached_graph = read_graph_columns(columns_data, header, file);
+    AdjacencyMatrix cached_inv_graph = read_graph_columns(columns_data + columns_size, header, file);
+    if ((cached_graph.is_valid() == false) || (cached_inv_graph.is_valid() == false)) {
+        return false;
+    }
+    graph = cached_graph;
+    inv_graph = cached_inv_graph;
+    return true;
+}
+
+
+bool convert_gr_files_to_graph_cache(std::string gr_file1, std::string gr_file2, std::string cache_file,
+                                     LoadStats *stats) {
+    size_t              graph_size;
+    std::vector<Edge>   edges;
+    if (load_gr_files(gr_file1, gr_file2, edges, graph_size, stats) == false) {
+        return false;
+    }
+
+    AdjacencyMatrix graph;
+    AdjacencyMatrix inv_graph;
+    AdjacencyMatrix::build_with_inverse(graph_size, edges, graph, inv_graph);
+    return save_graph_cache(cache_file, graph, inv_graph, {gr_file1, gr_file2});
+}
+
+
+bool convert_txt_file_to_graph_cache(std::string txt_file, std::string cache_file, LoadStats *stats) {
+    size_t              graph_size;
+    std::vector<Edge>   edges;
+    if (load_txt_file(txt_file, edges, graph_size, stats) == false) {
+        return false;
+    }
+
+    AdjacencyMatrix graph;
+    AdjacencyMatrix inv_graph;
+    AdjacencyMatrix::build_with_inverse(graph_size, edges, graph, inv_graph);
+    return save_graph_cache(cache_file, graph, inv_graph, {txt_file});
+}
+
+
+bool load_gr_files_cached(std::string gr_file1, std::string gr_file2, std::string cache_file,
+                          AdjacencyMatrix &graph, AdjacencyMatrix &inv_graph, LoadStats *stats) {
+    if (load_graph_cache(cache_file, graph, inv_graph, {gr_file1, gr_file2}) == true) {
+        return true;
+    }
+    if (convert_gr_files_to_graph_cache(gr_file1, gr_file2, cache_file, stats) == false) {
+        return false;
+    }
+    return load_graph_cache(cache_file, graph, inv_graph, {gr_file1, gr_file2});
+}
@@ -7,7 +7,42 @@
 #include <vector>
 #include "Definitions.h"
 
-bool load_gr_files(std::string gr_file1, std::string gr_file2, std::vector<Edge> &edges, size_t &graph_size);
+// Parsing statistics of the graph loaders
+struct LoadStats {
+    size_t  bytes   = 0;
+    size_t  threads = 0;
+    double  seconds = 0;
+
+    double throughput_mb_per_sec(void) const;
+};
+
+// Graph text loaders parse a memory mapped copy of the files in chunks on all available cores
+bool load_gr_files(std::string gr_file1, std::string gr_file2, std::vector<Edge> &edges, size_t &graph_size,
+                   LoadStats *stats=nullptr);
+// One gr file per objective, all listing the same arcs in the same order. Instantiated for 2 to 4 objectives.
+template<size_t N>
+bool load_gr_files(const Costs<std::string, N> &gr_files, std::vector<BasicEdge<N>> &edges, size_t &graph_size,
+                   LoadStats *stats=nullptr);
+bool load_txt_file(std::string txt_file, std::vector<Edge> &edges_out, size_t &graph_size, LoadStats *stats=nullptr);
 bool load_queries(std::string query_file, std::vector<std::pair<size_t, size_t>> &queries_out);
+// Vertex coordinates of a DIMACS co file, as listed
+bool load_co_file(std::string co_file, std::vector<std::pair<size_t, Pair<int64_t>>> &coordinates_out);
+
+// Binary graph cache holding the graph and its inverse with both costs, ready to be searched.
+// Loading memory maps the file and the returned graphs point straight into the mapping.
+// source_files are the files the graph was parsed from. Their sizes and modification times are saved
+// with the cache, and loading fails when they differ, so a stale cache is rebuilt. Loading without
+// source_files skips that check.
+bool save_graph_cache(std::string cache_file, const AdjacencyMatrix &graph, const AdjacencyMatrix &inv_graph,
+                      const std::vector<std::string> &source_files={});
+bool load_graph_cache(std::string cache_file, AdjacencyMatrix &graph, AdjacencyMatrix &inv_graph,
+                      const std::vector<std::string> &source_files={});
+bool convert_gr_files_to_graph_cache(std::string gr_file1, std::string gr_file2, std::string cache_file,
+                                     LoadStats *stats=nullptr);
+bool convert_txt_file_to_graph_cache(std::string txt_file, std::string cache_file, LoadStats *stats=nullptr);
+// Loads the graph cache, converting the gr files into it first if it can't be loaded or they changed.
+// stats are filled only when the gr files were parsed.
+bool load_gr_files_cached(std::string gr_file1, std::string gr_file2, std::string cache_file,
+                          AdjacencyMatrix &graph, AdjacencyMatrix &inv_graph, LoadStats *stats=nullptr);
 
 #endif //UTILS_IO_UTILS_H
@@ -0,0 +1,74 @@
+#include "LogSink.h"
+
+
+FileLogSink::FileLogSink(const std::string &filename)
+    : file(filename.c_str(), std::ofstream::out | std::ofstream::app | std::ofstream::binary) {}
+
+
+void FileLogSink::write(std::string &&data) {
+    this->file.write(data.data(), data.size());
+}
+
+
+void FileLogSink::flush(void) {
+    this->file.flush();
+}
+
+
+AsyncFileLogSink::AsyncFileLogSink(const std::string &filename)
+    : file(filename.c_str(), std::ofstream::out | std::ofstream::app | std::ofstream::binary) {
+    // Started last so every member is constructed before the thread uses it
+    this->writer = std::thread(&AsyncFileLogSink::write_pending, this);
+}
+
+
+AsyncFileLogSink::~AsyncFileLogSink() {
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->done = true;
+    }
+    this->pending_cv.notify_one();
+    this->writer.join();
+    this->file.flush();
+}
+
+
+void AsyncFileLogSink::write(std::string &&data) {
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->pending.push_back(std::move(data));
+    }
+    this->pending_cv.notify_one();
+}
+
+
+void AsyncFileLogSink::flush(void) {
+    std::unique_lock<std::mutex> lock(this->mutex);
+    this->idle_cv.wait(lock, [this]() {return this->pending.empty() && (this->writing == false);});
+    this->file.flush();
+}
+
+
+void AsyncFileLogSink::write_pending(void) {
+    std::unique_lock<std::mutex> lock(this->mutex);
+    while (true) {
+        this->pending_cv.wait(lock, [this]() {return this->done || (this->pending.empty() == false);});
+        if (this->pending.empty()) {
+            // done was set and everything queued is written
+            return;
+        }
+
+        std::string data = std::move(this->pending.front());
+        this->pending.pop_front();
+        this->writing = true;
+
+        lock.unlock();
+        this->file.write(data.data(), data.size());
+        lock.lock();
+
+        this->writing = false;
+        if (this->pending.empty()) {
+            this->idle_cv.notify_all();
+        }
+    }
+}
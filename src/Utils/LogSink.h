@@ -0,0 +1,57 @@
+#ifndef UTILS_LOG_SINK_H
+#define UTILS_LOG_SINK_H
+
+#include <string>
+#include <deque>
+#include <fstream>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+// Destination of the serialized log records. The Logger hands it whole buffers,
+// so a sink sees few large writes instead of one write per record.
+class LogSink {
+public:
+    virtual ~LogSink() = default;
+    virtual void write(std::string &&data) = 0;
+    // Blocks until all the data written so far reached its destination
+    virtual void flush(void) = 0;
+};
+
+
+// Writes the buffers to a file on the calling thread
+class FileLogSink : public LogSink {
+private:
+    std::ofstream   file;
+
+public:
+    // The file is appended to, like the original logger did
+    FileLogSink(const std::string &filename);
+    void write(std::string &&data) override;
+    void flush(void) override;
+};
+
+
+// Queues the buffers to a background thread which writes them to a file,
+// so file IO does not run inside the measured search time
+class AsyncFileLogSink : public LogSink {
+private:
+    std::ofstream               file;
+    std::deque<std::string>     pending;
+    bool                        writing = false;
+    bool                        done = false;
+    std::mutex                  mutex;
+    std::condition_variable     pending_cv;
+    std::condition_variable     idle_cv;
+    std::thread                 writer;
+
+    void write_pending(void);
+
+public:
+    AsyncFileLogSink(const std::string &filename);
+    ~AsyncFileLogSink();
+    void write(std::string &&data) override;
+    void flush(void) override;
+};
+
+#endif // UTILS_LOG_SINK_H
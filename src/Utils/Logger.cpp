@@ -1,68 +1,141 @@
 #include <string>
-#include <fstream>
 #include <chrono>
-#include <string>
 #include <ctime>
 #include "Logger.h"
 
 // All logging is done in JSON format. This in order to work with formal format
 // and allow simple connection to other frameworks/languages
 
-std::string insert_tabs_on_newline(std::string str, size_t tabs_amount) {
-    std::string replace_target = "\n";
-    while (tabs_amount != 0) {
-        tabs_amount -= 1;
-        replace_target += "\t";
-    }
+// Same format as std::ctime without the trailing newline, but safe to call from several threads
+std::string format_start_time(std::time_t time) {
+    std::tm local_time;
+#ifdef _WIN32
+    localtime_s(&local_time, &time);
+#else
+    localtime_r(&time, &local_time);
+#endif
+    char formatted[32];
+    size_t length = std::strftime(formatted, sizeof(formatted), "%a %b %e %H:%M:%S %Y", &local_time);
+    return std::string(formatted, length);
+}
+
+
+Logger::Logger(std::string filename, LogFormat format, bool async)
+    : Logger(async ? std::unique_ptr<LogSink>(new AsyncFileLogSink(filename))
+                   : std::unique_ptr<LogSink>(new FileLogSink(filename)),
+             format) {}
 
-    size_t pos = 0;
-    while ((pos = str.find("\n", pos)) != std::string::npos) {
-        str.replace(pos, 1, replace_target);
-        pos += replace_target.length();
+
+Logger::Logger(std::unique_ptr<LogSink> sink, LogFormat format)
+    : sink(std::move(sink)), format(format), first_entry(true) {
+    this->run_start_time = Clock::now();
+    if (this->format == LogFormat::JSON) {
+        this->buffer += "[\n"; // Start list of logs
     }
-    return str;
 }
 
 
-Logger::Logger(std::string filename)
-    : log_filestream(filename.c_str(), std::ofstream::out | std::ofstream::app), first_entry(true) {
+Logger::Logger(LogFormat format)
+    : format(format), first_entry(true) {
     this->run_start_time = Clock::now();
-    this->log_filestream << "[" << std::endl; // Start list of logs
 }
 
 
 Logger::~Logger() {
-    this->log_filestream << "]" << std::endl; // End list of logs
-    this->log_filestream.close();
+    if (this->sink != nullptr) {
+        if (this->format == LogFormat::JSON) {
+            this->buffer += "\n]\n"; // End list of logs
+        }
+        this->write_to_sink();
+        this->sink->flush();
+    }
 }
 
 
-void Logger::start_search(size_t source, size_t target, std::string search_info_json) {
+void Logger::start_entry() {
+    if (this->first_entry) {
+        this->first_entry = false;
+    } else if (this->format == LogFormat::JSON) {
+        this->buffer += ",\n";
+    }
+}
+
+
+void Logger::write_to_sink() {
+    if (this->buffer.empty() == false) {
+        std::string data;
+        data.swap(this->buffer);
+        this->sink->write(std::move(data));
+    }
+}
+
+
+void Logger::flush() {
+    if (this->sink != nullptr) {
+        this->write_to_sink();
+        this->sink->flush();
+    }
+}
+
+
+LogFormat Logger::get_format() const {
+    return this->format;
+}
+
+
+std::string Logger::take_buffered_entries() {
+    std::string entries;
+    entries.swap(this->buffer);
+    this->first_entry = true;
+    return entries;
+}
+
+
+void Logger::append_entries(const std::string &entries) {
+    if (entries.empty()) {
+        return;
+    }
+    this->start_entry();
+    this->buffer += entries;
+    if ((this->sink != nullptr) && (this->buffer.size() >= SINK_WRITE_THRESHOLD)) {
+        this->write_to_sink();
+    }
+}
+
+
+void Logger::start_search(size_t source, size_t target, const std::string &search_info_json) {
     std::time_t start_time = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
     this->run_start_time = Clock::now();
     this->total_run_duration_ms = 0;
     this->run_time_since_previous_log_ms = 0;
-    std::string string_start_time = std::ctime(&start_time);
-    string_start_time.pop_back();
-
-    if (first_entry) {
-        first_entry = false;
-    } else {
-        this->log_filestream << ",\n";
-    }
+    const char *separator = (this->format == LogFormat::JSON) ? ",\n\t" : ", ";
 
-    this->log_filestream << "{\n"
-                         <<     "\t\"start_time\": \"" << string_start_time << "\",\n"
-                         <<     "\t\"source\": " << source << ",\n"
-                         <<     "\t\"target\": " << target << ",\n"
-                         <<     "\t\"search_info\": " << insert_tabs_on_newline(search_info_json,2) << "," << std::endl;
+    this->start_entry();
+    this->buffer += (this->format == LogFormat::JSON) ? "{\n\t" : "{";
+    this->buffer += "\"start_time\": \"" + format_start_time(start_time) + "\"";
+    this->buffer += separator;
+    this->buffer += "\"source\": " + std::to_string(source);
+    this->buffer += separator;
+    this->buffer += "\"target\": " + std::to_string(target);
+    this->buffer += separator;
+    this->buffer += "\"search_info\": ";
+    this->buffer += search_info_json;
+    this->buffer += separator;
 }
 
 
-void Logger::finish_search(std::string finish_info_json) {
+void Logger::finish_search(const std::string &finish_info_json) {
     long int total_runtime_ms =
         std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - this->run_start_time).count();
-    this->log_filestream <<     "\t\"finish_info\": " << insert_tabs_on_newline(finish_info_json,2) << ",\n"
-                         <<     "\t\"total_runtime(ms)\": " << total_runtime_ms << "\n"
-                         << "}" << std::endl;
-}
\ No newline at end of file
+    const char *separator = (this->format == LogFormat::JSON) ? ",\n\t" : ", ";
+
+    this->buffer += "\"finish_info\": ";
+    this->buffer += finish_info_json;
+    this->buffer += separator;
+    this->buffer += "\"total_runtime(ms)\": " + std::to_string(total_runtime_ms);
+    this->buffer += (this->format == LogFormat::JSON) ? "\n}" : "}\n";
+
+    if ((this->sink != nullptr) && (this->buffer.size() >= SINK_WRITE_THRESHOLD)) {
+        this->write_to_sink();
+    }
+}
@@ -2,11 +2,10 @@
 #define UTILS_LOGGER_H
 
 #include <string>
-#include <fstream>
-#include <sstream>
 #include <memory>
 #include <chrono>
 #include "Definitions.h"
+#include "LogSink.h"
 
 #if (DEBUG >= 1)
 #define LOG_START_SEARCH(logger, source, target, message)   ((logger).start_search((source), (target), (message)));
@@ -22,22 +21,48 @@ using TimePoint = std::chrono::time_point<Clock>;
 class Logger;
 using LoggerPtr = Logger*;
 
+// JSON writes a single JSON list of records, NDJSON writes one compact record per line.
+// NDJSON logs can be converted back to a JSON list with log_converter.py.
+enum class LogFormat {JSON, NDJSON};
+
 // All logging is done in JSON format. This in order to work with formal format
-// and allow simple connection to other frameworks/languages
+// and allow simple connection to other frameworks/languages.
+// Records are serialized into an in memory buffer which is handed to the sink once it grows
+// large enough, by default an asynchronous file sink so disk writes stay off the search thread.
+// A Logger constructed without a filename or sink keeps its entries in memory, which lets
+// concurrent searches log separately and have their entries appended to a file logger later.
 class Logger
 {
 private:
-    TimePoint       run_start_time;
-    long int        total_run_duration_ms           = 0;
-    long int        run_time_since_previous_log_ms  = 0;
-    std::ofstream   log_filestream;
-    bool            first_entry;
+    static const size_t     SINK_WRITE_THRESHOLD = size_t(1) << 20;
+
+    TimePoint               run_start_time;
+    long int                total_run_duration_ms           = 0;
+    long int                run_time_since_previous_log_ms  = 0;
+    std::unique_ptr<LogSink> sink;
+    LogFormat               format;
+    std::string             buffer;
+    bool                    first_entry;
+
+    void start_entry(void);
+    void write_to_sink(void);
 
 public:
-    Logger(std::string filename);
+    Logger(std::string filename, LogFormat format=LogFormat::JSON, bool async=true);
+    Logger(std::unique_ptr<LogSink> sink, LogFormat format=LogFormat::JSON);
+    Logger(LogFormat format=LogFormat::JSON);
     ~Logger();
-    void start_search(size_t source, size_t target, std::string search_info_json);
-    void finish_search(std::string finish_info_json);
+    void start_search(size_t source, size_t target, const std::string &search_info_json);
+    void finish_search(const std::string &finish_info_json);
+    // Hands the buffered records to the sink and waits until they are written
+    void flush(void);
+
+    LogFormat get_format(void) const;
+
+    // Returns the buffered entries and clears the buffer (in memory loggers only)
+    std::string take_buffered_entries(void);
+    // Appends entries taken from an in memory logger of the same format
+    void append_entries(const std::string &entries);
 };
 
-#endif // UTILS_LOGGER_H
\ No newline at end of file
+#endif // UTILS_LOGGER_H
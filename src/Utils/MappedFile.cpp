@@ -0,0 +1,84 @@
+#include <fstream>
+#include "MappedFile.h"
+
+#if defined(_WIN32)
+#define MAPPED_FILE_USE_MMAP 0
+#else
+#define MAPPED_FILE_USE_MMAP 1
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+
+MappedFile::~MappedFile() {
+    this->close();
+}
+
+
+bool MappedFile::open(const std::string &filename) {
+    this->close();
+
+#if MAPPED_FILE_USE_MMAP
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+
+    struct stat file_stat;
+    if (fstat(fd, &file_stat) != 0) {
+        ::close(fd);
+        return false;
+    }
+
+    this->file_size = file_stat.st_size;
+    if (this->file_size > 0) {
+        void *mapping = mmap(nullptr, this->file_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapping == MAP_FAILED) {
+            ::close(fd);
+            this->file_size = 0;
+            return false;
+        }
+        madvise(mapping, this->file_size, MADV_WILLNEED);
+        this->file_data = static_cast<const char*>(mapping);
+    }
+
+    // The mapping stays valid after the descriptor is closed
+    ::close(fd);
+    return true;
+#else
+    std::ifstream file(filename.c_str(), std::ifstream::binary | std::ifstream::ate);
+    if (file.is_open() == false) {
+        return false;
+    }
+
+    this->buffer.resize(static_cast<size_t>(file.tellg()));
+    file.seekg(0);
+    if (file.read(this->buffer.data(), this->buffer.size()).fail()) {
+        this->buffer.clear();
+        return false;
+    }
+    this->file_data = this->buffer.data();
+    this->file_size = this->buffer.size();
+    return true;
+#endif
+}
+
+
+void MappedFile::close(void) {
+#if MAPPED_FILE_USE_MMAP
+    if (this->file_data != nullptr) {
+        munmap(const_cast<char*>(this->file_data), this->file_size);
+    }
+#endif
+    this->buffer.clear();
+    this->file_data = nullptr;
+    this->file_size = 0;
+}
+
+
+const char *MappedFile::data(void) const {return this->file_data;}
+
+
+size_t MappedFile::size(void) const {return this->file_size;}
@@ -0,0 +1,28 @@
+#ifndef UTILS_MAPPED_FILE_H
+#define UTILS_MAPPED_FILE_H
+
+#include <string>
+#include <vector>
+
+// Read-only view of a whole file. The file is memory mapped where the platform supports it,
+// otherwise it is read into memory at once.
+class MappedFile {
+private:
+    const char          *file_data  = nullptr;
+    size_t              file_size   = 0;
+    std::vector<char>   buffer;
+
+    void close(void);
+
+public:
+    MappedFile() = default;
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+    ~MappedFile();
+
+    bool open(const std::string &filename);
+    const char *data(void) const;
+    size_t size(void) const;
+};
+
+#endif //UTILS_MAPPED_FILE_H
@@ -0,0 +1,70 @@
+#include <algorithm>
+#include <functional>
+
+#include "OpenList.h"
+
+uint64_t open_list_key(const Node &node) {
+    // Node costs are 32 bits, so both of them fit into the key
+    static_assert(sizeof(NodeCost) <= sizeof(uint32_t), "Node costs must fit in half of the key");
+    return (static_cast<uint64_t>(node.f[0]) << 32) | static_cast<uint64_t>(node.f[1]);
+}
+
+
+bool BinaryHeapOpenList::empty() const {
+    return this->heap.empty();
+}
+
+size_t BinaryHeapOpenList::size() const {
+    return this->heap.size();
+}
+
+void BinaryHeapOpenList::insert(NodePtr node) {
+    this->heap.push_back({open_list_key(*node), node});
+    std::push_heap(this->heap.begin(), this->heap.end(), std::greater<HeapEntry>());
+}
+
+NodePtr BinaryHeapOpenList::pop() {
+    std::pop_heap(this->heap.begin(), this->heap.end(), std::greater<HeapEntry>());
+    NodePtr node = this->heap.back().node;
+    this->heap.pop_back();
+    return node;
+}
+
+uint64_t BinaryHeapOpenList::top_key() const {
+    return this->heap.front().key;
+}
+
+size_t BinaryHeapOpenList::entry_bytes() {
+    return sizeof(HeapEntry);
+}
+
+
+bool RadixHeapOpenList::empty() const {
+    return this->heap.empty() && this->backward_nodes.empty();
+}
+
+size_t RadixHeapOpenList::size() const {
+    return this->heap.size() + this->backward_nodes.size();
+}
+
+void RadixHeapOpenList::insert(NodePtr node) {
+    uint64_t key = open_list_key(*node);
+    if (this->heap.accepts(key)) {
+        this->heap.push(key, node);
+    } else {
+        this->backward_nodes.insert(node);
+    }
+}
+
+NodePtr RadixHeapOpenList::pop() {
+    if (this->backward_nodes.empty() == false) {
+        if (this->heap.empty() || (this->backward_nodes.top_key() < this->heap.top().first)) {
+            return this->backward_nodes.pop();
+        }
+    }
+    return this->heap.pop().second;
+}
+
+size_t RadixHeapOpenList::entry_bytes() {
+    return sizeof(RadixHeap<NodePtr>::Entry);
+}
@@ -0,0 +1,65 @@
+#ifndef UTILS_OPEN_LIST_H
+#define UTILS_OPEN_LIST_H
+
+#include <vector>
+#include <cstdint>
+#include "Definitions.h"
+#include "RadixHeap.h"
+
+// Open list policies for BOAStar. Both pop nodes by minimal f (min f[0], min f[1] if equal).
+// The radix heap is fastest with a consistent heuristic, with an inconsistent one the nodes whose
+// f went backwards are kept in a binary heap next to it.
+enum class OpenListType {
+    BINARY_HEAP,
+    RADIX_HEAP
+};
+
+
+// Both open lists order nodes by f[0] and f[1] packed into a single 64 bit key, which is kept
+// inline in their entries so comparisons never dereference the nodes
+uint64_t open_list_key(const Node &node);
+
+
+// Binary heap of node pointers along with their keys
+class BinaryHeapOpenList {
+private:
+    struct HeapEntry {
+        uint64_t    key;
+        NodePtr     node;
+
+        bool operator>(const HeapEntry &other) const {return this->key > other.key;}
+    };
+
+    std::vector<HeapEntry>  heap;
+
+public:
+    bool empty(void) const;
+    size_t size(void) const;
+    void insert(NodePtr node);
+    NodePtr pop(void);
+    // Key of the node pop() returns next
+    uint64_t top_key(void) const;
+    // Memory taken by an entry of the open list
+    static size_t entry_bytes(void);
+};
+
+
+// Monotone radix heap over the same keys. Gives amortized O(log C) operations with a consistent
+// heuristic, where no node is inserted with f smaller than the last popped f. Nodes that are, which
+// an admissible but inconsistent heuristic allows, are kept in a binary heap instead, so any
+// admissible heuristic works but only consistent ones get the radix heap for every node.
+class RadixHeapOpenList {
+private:
+    RadixHeap<NodePtr>  heap;
+    BinaryHeapOpenList  backward_nodes;
+
+public:
+    bool empty(void) const;
+    size_t size(void) const;
+    void insert(NodePtr node);
+    NodePtr pop(void);
+    // Memory taken by an entry of the open list
+    static size_t entry_bytes(void);
+};
+
+#endif //UTILS_OPEN_LIST_H
@@ -2,47 +2,187 @@
 
 #include "PPQueue.h"
 
+PPQueue::PPQueue()
+    : open_map({nullptr, nullptr}) {}
+
 PPQueue::PPQueue(size_t graph_size)
-    : open_map(graph_size, std::vector<PathPairPtr>()) {
+    : open_map({nullptr, nullptr}) {
+    this->clear(graph_size);
+}
+
+void PPQueue::clear(size_t graph_size) {
+    this->heap.clear();
+    this->open_map.reset(graph_size);
+    this->tombstones_avoided = 0;
+}
 
-    std::make_heap(this->heap.begin(), this->heap.end(), this->more_than);
+void PPQueue::release() {
+    std::vector<HeapEntry>().swap(this->heap);
+    this->open_map.release();
 }
 
 bool PPQueue::empty() {
     return this->heap.empty();
 }
 
-PathPairPtr PPQueue::top() {
-    return this->heap.back();
+size_t PPQueue::size() const {
+    return this->heap.size();
 }
 
-PathPairPtr PPQueue::pop() {
-    // Pop from min heap
-    std::pop_heap(this->heap.begin(), this->heap.end(), this->more_than);
-    PathPairPtr pp = this->heap.back();
-    this->heap.pop_back();
+PathPairPtr PPQueue::top() {
+    return this->heap.front().pp;
+}
 
-    // Remove from open map
-    std::vector<PathPairPtr> &relevant_pps = this->open_map[pp->id];
-    for (auto iter = relevant_pps.begin(); iter != relevant_pps.end(); ++iter) {
-        if (pp == *iter) {
-            relevant_pps.erase(iter);
-            break;
+void PPQueue::top(size_t amount, std::vector<PathPairPtr> &pps) const {
+    // Best first walk down the heap, the children of a listed entry are the only new candidates
+    auto more = [this](size_t a, size_t b) {return this->heap[a] > this->heap[b];};
+    std::vector<size_t> candidates;
+    if (this->heap.empty() == false) {
+        candidates.push_back(0);
+    }
+    for (size_t listed = 0; (listed < amount) && (candidates.empty() == false); listed++) {
+        std::pop_heap(candidates.begin(), candidates.end(), more);
+        size_t heap_idx = candidates.back();
+        candidates.pop_back();
+        pps.push_back(this->heap[heap_idx].pp);
+        for (size_t child_idx = 2*heap_idx+1; (child_idx <= 2*heap_idx+2) && (child_idx < this->heap.size()); child_idx++) {
+            candidates.push_back(child_idx);
+            std::push_heap(candidates.begin(), candidates.end(), more);
         }
     }
+}
 
+PathPairPtr PPQueue::pop() {
+    PathPairPtr pp = this->heap.front().pp;
+    this->erase(pp);
     return pp;
 }
 
 void PPQueue::insert(PathPairPtr &pp) {
     // Insert to min heap
-    this->heap.push_back(pp);
-    std::push_heap(this->heap.begin(), this->heap.end(), this->more_than);
+    this->heap.push_back({sort_key(*pp), pp});
+    pp->heap_idx = this->heap.size()-1;
+    this->sift_up(pp->heap_idx);
+
+    this->append_open(pp);
+}
+
+void PPQueue::update(PathPairPtr &pp) {
+    this->tombstones_avoided++;
+    this->heap[pp->heap_idx].key = sort_key(*pp);
+    this->sift_up(pp->heap_idx);
+    this->sift_down(pp->heap_idx);
+
+    // The updated path pair counts as newly inserted in the open list of its vertex
+    if (pp->next_open != nullptr) {
+        this->unlink_open(pp);
+        this->append_open(pp);
+    }
+}
+
+void PPQueue::remove(PathPairPtr &pp) {
+    this->tombstones_avoided++;
+    this->erase(pp);
+}
 
-    // Insert to open map
-    this->open_map[pp->id].push_back(pp);
+PathPairPtr PPQueue::get_open_pps(size_t id) {
+    return this->open_map.get(id).head;
 }
 
-std::vector<PathPairPtr> &PPQueue::get_open_pps(size_t id) {
-	return this->open_map[id];
+size_t PPQueue::get_tombstones_avoided() const {
+    return this->tombstones_avoided;
+}
+
+size_t PPQueue::entry_bytes() {
+    return sizeof(HeapEntry);
+}
+
+uint64_t PPQueue::sort_key(const PathPair &pp) {
+    return (static_cast<uint64_t>(pp.top_left->f[0]) << 32) | static_cast<uint64_t>(pp.bottom_right->f[1]);
+}
+
+void PPQueue::erase(PathPairPtr &pp) {
+    // Remove from min heap by moving the last entry into its position
+    size_t heap_idx = pp->heap_idx;
+    HeapEntry last = this->heap.back();
+    this->heap.pop_back();
+    if (last.pp != pp) {
+        this->place(heap_idx, last);
+        this->sift_up(heap_idx);
+        this->sift_down(last.pp->heap_idx);
+    }
+
+    this->unlink_open(pp);
+}
+
+void PPQueue::append_open(PathPairPtr &pp) {
+    OpenList open_list = this->open_map.get(pp->id);
+    pp->prev_open = open_list.tail;
+    pp->next_open = nullptr;
+    if (open_list.tail != nullptr) {
+        open_list.tail->next_open = pp;
+    } else {
+        open_list.head = pp;
+    }
+    open_list.tail = pp;
+    this->open_map.set(pp->id, open_list);
+}
+
+void PPQueue::unlink_open(PathPairPtr &pp) {
+    if ((pp->prev_open == nullptr) || (pp->next_open == nullptr)) {
+        OpenList open_list = this->open_map.get(pp->id);
+        if (pp->prev_open == nullptr) {
+            open_list.head = pp->next_open;
+        }
+        if (pp->next_open == nullptr) {
+            open_list.tail = pp->prev_open;
+        }
+        this->open_map.set(pp->id, open_list);
+    }
+    if (pp->prev_open != nullptr) {
+        pp->prev_open->next_open = pp->next_open;
+    }
+    if (pp->next_open != nullptr) {
+        pp->next_open->prev_open = pp->prev_open;
+    }
+    pp->prev_open = nullptr;
+    pp->next_open = nullptr;
+}
+
+void PPQueue::place(size_t heap_idx, const HeapEntry &entry) {
+    this->heap[heap_idx] = entry;
+    entry.pp->heap_idx = heap_idx;
+}
+
+void PPQueue::sift_up(size_t heap_idx) {
+    HeapEntry entry = this->heap[heap_idx];
+    while (heap_idx > 0) {
+        size_t parent_idx = (heap_idx-1) / 2;
+        if ((this->heap[parent_idx] > entry) == false) {
+            break;
+        }
+        this->place(heap_idx, this->heap[parent_idx]);
+        heap_idx = parent_idx;
+    }
+    this->place(heap_idx, entry);
+}
+
+void PPQueue::sift_down(size_t heap_idx) {
+    HeapEntry entry = this->heap[heap_idx];
+    size_t heap_size = this->heap.size();
+    while (true) {
+        size_t child_idx = 2*heap_idx + 1;
+        if (child_idx >= heap_size) {
+            break;
+        }
+        if ((child_idx+1 < heap_size) && (this->heap[child_idx] > this->heap[child_idx+1])) {
+            child_idx++;
+        }
+        if ((entry > this->heap[child_idx]) == false) {
+            break;
+        }
+        this->place(heap_idx, this->heap[child_idx]);
+        heap_idx = child_idx;
+    }
+    this->place(heap_idx, entry);
 }
@@ -1,28 +1,71 @@
 #ifndef UTILS_PP_QUEUE_H
 #define UTILS_PP_QUEUE_H
 
-#include <set>
 #include <vector>
-#include <list>
 #include "../Utils/Definitions.h"
+#include "../Utils/GenerationArray.h"
 
+// Min heap of path pairs with per vertex lists of the open path pairs.
+// Every path pair knows its heap position and is linked into the list of its vertex,
+// so path pairs can be updated or removed in place instead of being left in the heap.
 class PPQueue
 {
 private:
-    std::vector<PathPairPtr>                heap;
-    PathPair::more_than_full_cost           more_than;
+    // Heap entries keep the sort key inline so comparisons don't dereference the path pairs.
+    // The key packs f1 of the top left node above f2 of the bottom right one.
+    struct HeapEntry {
+        uint64_t    key;
+        PathPairPtr pp;
 
-    std::vector<std::vector<PathPairPtr>>   open_map;
+        bool operator>(const HeapEntry &other) const {return this->key > other.key;}
+    };
+
+    static uint64_t sort_key(const PathPair &pp);
+
+    std::vector<HeapEntry>                  heap;
+
+    // Path pairs are appended to the list of their vertex, so it is scanned oldest first
+    struct OpenList {
+        PathPairPtr head;
+        PathPairPtr tail;
+    };
+
+    GenerationArray<OpenList>               open_map;
+    size_t                                  tombstones_avoided = 0;
+
+    void place(size_t heap_idx, const HeapEntry &entry);
+    void sift_up(size_t heap_idx);
+    void sift_down(size_t heap_idx);
+    void erase(PathPairPtr &pp);
+    void append_open(PathPairPtr &pp);
+    void unlink_open(PathPairPtr &pp);
 
 public:
+    PPQueue();
     PPQueue(size_t graph_size);
+    // Empties the queue, the open map is reset lazily
+    void clear(size_t graph_size);
+    // Frees the heap and the open map, clear() must be called before the next use
+    void release();
     bool empty();
+    size_t size() const;
     PathPairPtr top();
+    // Appends up to amount of the path pairs with the smallest keys, in key order, without changing
+    // the queue. Path pairs with equal keys may be listed in another order than they would be popped.
+    void top(size_t amount, std::vector<PathPairPtr> &pps) const;
     PathPairPtr pop();
     void insert(PathPairPtr &pp);
-    std::vector<PathPairPtr> &get_open_pps(size_t id);
-
+    // Restores the heap order after the nodes of pp were changed in place, and moves pp to the end of
+    // the open list of its vertex where a new path pair replacing it would have been inserted
+    void update(PathPairPtr &pp);
+    void remove(PathPairPtr &pp);
+    // Head of the open path pairs list of the vertex, continue with PathPair::next_open.
+    // The list is in insertion order, oldest first.
+    PathPairPtr get_open_pps(size_t id);
+    // Amount of updates and removals that would have left a deactivated entry in the heap
+    size_t get_tombstones_avoided() const;
+    // Memory taken by a heap entry
+    static size_t entry_bytes();
 };
 
 #endif //UTILS_PP_QUEUE_H
-
@@ -0,0 +1,88 @@
+#include <algorithm>
+#include <stdexcept>
+
+#include "ParetoFront.h"
+
+ParetoFront::ParetoFront()
+    : offsets(1, 0) {}
+
+
+void ParetoFront::assign(const SolutionSet &solutions, const NodePool &nodes, const ContractionHierarchy *hierarchy,
+                         const QueryGraph *query_graph) {
+    if ((hierarchy == nullptr) != (query_graph == nullptr)) {
+        throw std::invalid_argument("Solutions on a hierarchy need the query graph they were found on");
+    }
+    this->clear();
+    this->costs.reserve(solutions.size());
+    this->offsets.reserve(solutions.size()+1);
+
+    std::vector<const Node*> path;
+    for (auto solution = solutions.begin(); solution != solutions.end(); ++solution) {
+        // Parents are walked from the target, so the path is emitted backwards afterwards
+        path.clear();
+        for (const Node *node = *solution; ; node = &nodes[node->parent]) {
+            path.push_back(node);
+            if (node->parent == NULL_HANDLE) {
+                break;
+            }
+        }
+
+        if (hierarchy == nullptr) {
+            for (size_t i = path.size(); i > 0; i--) {
+                this->vertices.push_back(path[i-1]->id);
+            }
+        } else {
+            this->vertices.push_back(query_graph->vertices[path.back()->id]);
+            for (size_t i = path.size()-1; i > 0; i--) {
+                const Node &parent = *path[i];
+                const Node &node = *path[i-1];
+                hierarchy->unpack_edge(query_graph->vertices[parent.id], query_graph->vertices[node.id],
+                                       {size_t(node.g[0]) - parent.g[0], size_t(node.g[1]) - parent.g[1]},
+                                       this->vertices);
+            }
+        }
+
+        if (this->vertices.size() > std::numeric_limits<uint32_t>::max()) {
+            throw std::length_error("Pareto front paths are too long for 32 bit offsets");
+        }
+        this->costs.push_back({(*solution)->g[0], (*solution)->g[1]});
+        this->offsets.push_back(this->vertices.size());
+    }
+}
+
+
+void ParetoFront::clear() {
+    this->costs.clear();
+    this->offsets.assign(1, 0);
+    this->vertices.clear();
+}
+
+
+void ParetoFront::to_original_ids(const VertexOrder &order) {
+    for (auto vertex = this->vertices.begin(); vertex != this->vertices.end(); ++vertex) {
+        *vertex = order.to_original(*vertex);
+    }
+}
+
+
+size_t ParetoFront::memory_bytes() const {
+    return this->costs.capacity()*sizeof(Pair<size_t>) +
+           this->offsets.capacity()*sizeof(uint32_t) +
+           this->vertices.capacity()*sizeof(uint32_t);
+}
+
+
+std::ostream& operator<<(std::ostream &stream, const ParetoFront &front) {
+    stream << "[";
+    for (size_t solution_idx = 0; solution_idx < front.size(); solution_idx++) {
+        ParetoFront::Path path = front.get_path(solution_idx);
+        stream << (solution_idx == 0 ? "" : ", ")
+               << "{\"costs\": " << front.get_costs(solution_idx) << ", \"path\": [";
+        for (size_t i = 0; i < path.size; i++) {
+            stream << (i == 0 ? "" : ", ") << path.vertices[i];
+        }
+        stream << "]}";
+    }
+    stream << "]";
+    return stream;
+}
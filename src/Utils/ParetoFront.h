@@ -0,0 +1,59 @@
+#ifndef UTILS_PARETO_FRONT_H
+#define UTILS_PARETO_FRONT_H
+
+#include <vector>
+#include <iostream>
+#include <cstdint>
+#include "Definitions.h"
+#include "ContractionHierarchy.h"
+#include "VertexOrder.h"
+
+// Self contained copy of the solutions of a search: the costs of each solution and its path
+// from source to target, all paths sharing one vertex buffer. Unlike a SolutionSet it does not
+// point into the node pool, so the search workspace can be released or reused right after assign().
+// Assigning again reuses the buffers.
+class ParetoFront {
+private:
+    std::vector<Pair<size_t>>   costs;
+    // Path of solution i is vertices[offsets[i]] until vertices[offsets[i+1]]
+    std::vector<uint32_t>       offsets;
+    std::vector<uint32_t>       vertices;
+
+public:
+    // View over the vertices of a single path, from source to target
+    struct Path {
+        const uint32_t  *vertices;
+        size_t          size;
+    };
+
+    ParetoFront();
+
+    // Copies the solutions, whose nodes live in nodes, by walking their parents.
+    // Solutions of a search on a hierarchy query graph have their vertices mapped back to the hierarchy
+    // and their shortcuts unpacked through it.
+    void assign(const SolutionSet &solutions, const NodePool &nodes, const ContractionHierarchy *hierarchy=nullptr,
+                const QueryGraph *query_graph=nullptr);
+    void clear(void);
+    // Maps the path vertices of solutions found on a reordered graph back to their original ids
+    void to_original_ids(const VertexOrder &order);
+
+    size_t size(void) const {return this->costs.size();}
+    const Pair<size_t> &get_costs(size_t solution_idx) const {return this->costs[solution_idx];}
+    Path get_path(size_t solution_idx) const {
+        return {this->vertices.data() + this->offsets[solution_idx],
+                this->offsets[solution_idx+1] - this->offsets[solution_idx]};
+    }
+
+    // Flat buffers for serialization, offsets holds size()+1 entries
+    const uint32_t *get_offsets(void) const {return this->offsets.data();}
+    const uint32_t *get_vertices(void) const {return this->vertices.data();}
+    size_t vertices_count(void) const {return this->vertices.size();}
+
+    // Memory held by the buffers
+    size_t memory_bytes(void) const;
+};
+
+// Printed in JSON format
+std::ostream& operator<<(std::ostream &stream, const ParetoFront &front);
+
+#endif //UTILS_PARETO_FRONT_H
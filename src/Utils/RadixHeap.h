@@ -0,0 +1,84 @@
+#ifndef UTILS_RADIX_HEAP_H
+#define UTILS_RADIX_HEAP_H
+
+#include <array>
+#include <vector>
+#include <utility>
+#include <cstdint>
+#include <algorithm>
+#include <stdexcept>
+
+// Monotone radix heap over 64 bit keys. Keys pushed must not be smaller than the last popped key,
+// which holds for Dijkstra and A* with a consistent heuristic. Operations are amortized O(log C).
+template<typename T>
+class RadixHeap {
+public:
+    using Entry = std::pair<uint64_t, T>;
+
+private:
+    static const size_t BUCKETS_AMOUNT = 65;
+
+    std::array<std::vector<Entry>, BUCKETS_AMOUNT>  buckets;
+    uint64_t                                        last_key = 0;
+    size_t                                          entries_amount = 0;
+
+    size_t bucket_idx(uint64_t key) const {
+        // Bucket i holds keys whose highest bit differing from last_key is bit i-1
+        uint64_t diff = key ^ this->last_key;
+        return diff == 0 ? 0 : 64 - __builtin_clzll(diff);
+    }
+
+public:
+    bool empty(void) const {return this->entries_amount == 0;}
+
+    size_t size(void) const {return this->entries_amount;}
+
+    // Whether key can be pushed, i.e. is not smaller than the last popped key
+    bool accepts(uint64_t key) const {return key >= this->last_key;}
+
+    void push(uint64_t key, const T &value) {
+        if (key < this->last_key) {
+            throw std::logic_error("Radix heap keys must be monotone");
+        }
+        this->buckets[this->bucket_idx(key)].emplace_back(key, value);
+        this->entries_amount++;
+    }
+
+    // Entry with the minimal key, after which only keys not smaller than it can be pushed
+    const Entry &top(void) {
+        if (this->buckets[0].empty()) {
+            // Advance last_key to the minimal key of the first non empty bucket and redistribute it,
+            // all of its entries move to lower buckets as they now share more high bits with last_key
+            size_t idx = 1;
+            while (this->buckets[idx].empty()) {
+                idx++;
+            }
+
+            std::vector<Entry> &bucket = this->buckets[idx];
+            this->last_key = std::min_element(bucket.begin(), bucket.end(),
+                                              [](const Entry &a, const Entry &b) {return a.first < b.first;})->first;
+            for (auto entry = bucket.begin(); entry != bucket.end(); ++entry) {
+                this->buckets[this->bucket_idx(entry->first)].push_back(*entry);
+            }
+            bucket.clear();
+        }
+        return this->buckets[0].back();
+    }
+
+    Entry pop(void) {
+        Entry entry = this->top();
+        this->buckets[0].pop_back();
+        this->entries_amount--;
+        return entry;
+    }
+
+    void clear(void) {
+        for (auto bucket = this->buckets.begin(); bucket != this->buckets.end(); ++bucket) {
+            bucket->clear();
+        }
+        this->last_key = 0;
+        this->entries_amount = 0;
+    }
+};
+
+#endif //UTILS_RADIX_HEAP_H
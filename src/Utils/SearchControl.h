@@ -0,0 +1,90 @@
+#ifndef UTILS_SEARCH_CONTROL_H
+#define UTILS_SEARCH_CONTROL_H
+
+#include <atomic>
+#include <vector>
+#include <algorithm>
+#include <limits>
+#include <functional>
+#include "Definitions.h"
+#include "SearchStats.h"
+
+// Anytime interface of BOAStar and PPA, given to a search with set_control().
+// on_solution is called with every solution the moment it is final, i.e. it is part of the solution
+// set the search is going to return. Returning false stops the search, which then returns the
+// solutions found so far. The search also stops once cancelled is set, on the deadline or after
+// max_expansions expansions. Solutions found by then but not delivered yet are delivered before it
+// returns. A search stopped early returns a subset of its full solution set, without the eps guarantee.
+// With relaxed_eps set, exceeding the relaxation budgets degrades the search instead of stopping it:
+// the search continues with the next eps of relaxed_eps (unless its own eps is larger), and the budgets
+// of the following level are multiplied by its number, i.e. the second relaxation happens at twice the
+// budgets. Merges and prunes done with the smaller eps remain within the larger one, so the solutions
+// keep the guarantee of the last eps used, which is reported in SearchStats::achieved_eps.
+struct SearchControl {
+    // The node is valid until the next search in the workspace, walk its parents through nodes
+    std::function<bool(const Node &solution, const NodePool &nodes)>    on_solution;
+    const std::atomic<bool>                                             *cancelled          = nullptr;
+    StatsClock::time_point                                              deadline            = StatsClock::time_point::max();
+    size_t                                                              max_expansions      = std::numeric_limits<size_t>::max();
+
+    // Increasing eps levels of the adaptive mode, empty to keep the eps of the search
+    std::vector<double>                                                 relaxed_eps;
+    size_t                                                              relax_nodes         = std::numeric_limits<size_t>::max();
+    size_t                                                              relax_memory_bytes  = std::numeric_limits<size_t>::max();
+    StatsClock::duration                                                relax_time          = StatsClock::duration::max();
+
+    // Reading the clock on every pop would show in the search time
+    static const size_t CLOCK_CHECK_INTERVAL = 256;
+
+    // Called by the searches on every pop
+    SearchStatus check_limits(const SearchStats &stats) const {
+        if ((this->cancelled != nullptr) && this->cancelled->load(std::memory_order_relaxed)) {
+            return SearchStatus::CANCELLED;
+        }
+        if (stats.nodes_expanded >= this->max_expansions) {
+            return SearchStatus::EXPANSIONS_EXHAUSTED;
+        }
+        if ((stats.heap_pops % CLOCK_CHECK_INTERVAL == 0) && (StatsClock::now() >= this->deadline)) {
+            return SearchStatus::DEADLINE_REACHED;
+        }
+        return SearchStatus::COMPLETE;
+    }
+
+    // Called by the searches every CLOCK_CHECK_INTERVAL pops, level is the amount of relaxations done
+    bool exceeds_relaxation_budget(size_t level, const SearchStats &stats, size_t memory_bytes,
+                                   StatsClock::time_point search_start) const {
+        if (level >= this->relaxed_eps.size()) {
+            return false;
+        }
+        // Budgets are divided instead of multiplied, so the unlimited ones don't overflow
+        size_t scale = level+1;
+        return (stats.nodes_generated/scale >= this->relax_nodes) ||
+               (memory_bytes/scale >= this->relax_memory_bytes) ||
+               ((StatsClock::now() - search_start)/scale >= this->relax_time);
+    }
+};
+
+
+// Eps of a search after relaxing it to eps_level
+inline Pair<double> relax_eps(const Pair<double> &eps, double eps_level) {
+    return {std::max(eps[0], eps_level), std::max(eps[1], eps_level)};
+}
+
+
+// Called by the searches with each final solution. Returns false if the search should stop.
+inline bool deliver_solution(const SearchControl *control, const Node &solution, const NodePool &nodes,
+                             StatsClock::time_point search_start, SearchStats &stats) {
+    if (stats.first_solution_ns == 0) {
+        stats.first_solution_ns = SearchStats::elapsed_ns(search_start);
+    }
+    if ((control == nullptr) || (control->on_solution == nullptr) || (stats.status == SearchStatus::STOPPED)) {
+        return true;
+    }
+    if (control->on_solution(solution, nodes) == false) {
+        stats.status = SearchStatus::STOPPED;
+        return false;
+    }
+    return true;
+}
+
+#endif //UTILS_SEARCH_CONTROL_H
@@ -0,0 +1,38 @@
+#include "SearchStats.h"
+
+const char *to_string(SearchStatus status) {
+    switch (status) {
+        case SearchStatus::COMPLETE:                return "complete";
+        case SearchStatus::STOPPED:                 return "stopped";
+        case SearchStatus::CANCELLED:               return "cancelled";
+        case SearchStatus::DEADLINE_REACHED:        return "deadline_reached";
+        case SearchStatus::EXPANSIONS_EXHAUSTED:    return "expansions_exhausted";
+    }
+    return "unknown";
+}
+
+
+std::ostream& operator<<(std::ostream &stream, const SearchStats &stats) {
+    // Printed in JSON format
+    stream
+        << "{"
+        <<      "\"nodes_generated\": " << stats.nodes_generated << ", "
+        <<      "\"nodes_expanded\": " << stats.nodes_expanded << ", "
+        <<      "\"pruned_by_target\": " << stats.pruned_by_target << ", "
+        <<      "\"pruned_by_vertex\": " << stats.pruned_by_vertex << ", "
+        <<      "\"heap_pushes\": " << stats.heap_pushes << ", "
+        <<      "\"heap_pops\": " << stats.heap_pops << ", "
+        <<      "\"merges\": " << stats.merges << ", "
+        <<      "\"tombstones_avoided\": " << stats.tombstones_avoided << ", "
+        <<      "\"peak_open_size\": " << stats.peak_open_size << ", "
+        <<      "\"peak_memory_bytes\": " << stats.peak_memory_bytes << ", "
+        <<      "\"heuristic_ns\": " << stats.heuristic_ns << ", "
+        <<      "\"search_ns\": " << stats.search_ns << ", "
+        <<      "\"reconstruction_ns\": " << stats.reconstruction_ns << ", "
+        <<      "\"first_solution_ns\": " << stats.first_solution_ns << ", "
+        <<      "\"status\": \"" << to_string(stats.status) << "\", "
+        <<      "\"achieved_eps\": " << stats.achieved_eps << ", "
+        <<      "\"eps_relaxations\": " << stats.eps_relaxations
+        << "}";
+    return stream;
+}
@@ -0,0 +1,72 @@
+#ifndef UTILS_SEARCH_STATS_H
+#define UTILS_SEARCH_STATS_H
+
+#include <cstdint>
+#include <chrono>
+#include <ostream>
+
+using StatsClock = std::chrono::steady_clock;
+
+// How a search ended, searches stop early only when given a SearchControl
+enum class SearchStatus {
+    COMPLETE,
+    // The solution callback asked to stop
+    STOPPED,
+    CANCELLED,
+    DEADLINE_REACHED,
+    EXPANSIONS_EXHAUSTED
+};
+
+const char *to_string(SearchStatus status);
+
+// Counters and phase timers of a single search, filled by BOAStar and PPA.
+// PPA counts path pairs where BOAStar counts nodes.
+struct SearchStats {
+    size_t      nodes_generated         = 0;
+    size_t      nodes_expanded          = 0;
+    // Pruned by the f2 bound of the target and by the g2 bound of the node's own vertex,
+    // both on generation and on pop
+    size_t      pruned_by_target        = 0;
+    size_t      pruned_by_vertex        = 0;
+    size_t      heap_pushes             = 0;
+    size_t      heap_pops               = 0;
+    // PPA only, path pairs merged into an open path pair instead of being pushed
+    size_t      merges                  = 0;
+    // PPA only, updates and removals done in place instead of leaving a deactivated entry
+    size_t      tombstones_avoided      = 0;
+    size_t      peak_open_size          = 0;
+    // Nodes, path pairs and open list entries allocated by the search
+    size_t      peak_memory_bytes       = 0;
+    // Precomputation time reported by the heuristic, 0 if it does not report one
+    uint64_t    heuristic_ns            = 0;
+    uint64_t    search_ns               = 0;
+    // Building the returned solution set from the solutions found by the search
+    uint64_t    reconstruction_ns       = 0;
+    // Time from the search start until its first solution was final, 0 if there was none
+    uint64_t    first_solution_ns       = 0;
+    SearchStatus status                 = SearchStatus::COMPLETE;
+    // Eps the solutions are guaranteed to be within, larger than the eps of the search if it was relaxed
+    double      achieved_eps            = 0;
+    size_t      eps_relaxations         = 0;
+
+    static uint64_t elapsed_ns(StatsClock::time_point since) {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(StatsClock::now() - since).count();
+    }
+};
+
+// Printed as a single line JSON object
+std::ostream& operator<<(std::ostream &stream, const SearchStats &stats);
+
+
+// Heuristics which precompute their values can report the time it took through get_compute_time_ns()
+template<typename HeuristicT>
+auto heuristic_compute_time_ns(const HeuristicT &heuristic, int) -> decltype(uint64_t(heuristic.get_compute_time_ns())) {
+    return heuristic.get_compute_time_ns();
+}
+
+template<typename HeuristicT>
+uint64_t heuristic_compute_time_ns(const HeuristicT &, long) {
+    return 0;
+}
+
+#endif //UTILS_SEARCH_STATS_H
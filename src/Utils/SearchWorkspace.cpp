@@ -0,0 +1,19 @@
+#include "SearchWorkspace.h"
+
+SearchWorkspace::SearchWorkspace()
+    : min_g2(MAX_COST) {}
+
+void SearchWorkspace::reset(size_t graph_size) {
+    // Nodes and path pairs of the previous search are released at once
+    this->nodes.clear();
+    this->path_pairs.clear();
+    this->min_g2.reset(graph_size+1);
+    this->pp_queue.clear(graph_size+1);
+}
+
+void SearchWorkspace::release() {
+    this->nodes.release();
+    this->path_pairs.release();
+    this->min_g2.release();
+    this->pp_queue.release();
+}
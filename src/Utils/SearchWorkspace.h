@@ -0,0 +1,25 @@
+#ifndef UTILS_SEARCH_WORKSPACE_H
+#define UTILS_SEARCH_WORKSPACE_H
+
+#include "Definitions.h"
+#include "GenerationArray.h"
+#include "PPQueue.h"
+
+// Scratch memory of BOAStar and PPA that is kept between searches. Resetting it does not
+// touch the per vertex arrays, so the setup cost of a search does not depend on the graph size.
+// A workspace can be shared by any amount of searches as long as they don't run concurrently.
+struct SearchWorkspace {
+    NodePool                nodes;
+    PathPairPool            path_pairs;
+    // Mininum cost of 2nd criteria per node
+    GenerationArray<size_t> min_g2;
+    PPQueue                 pp_queue;
+
+    SearchWorkspace();
+    void reset(size_t graph_size);
+    // Frees all the memory of the workspace, e.g. once the solutions were copied into a ParetoFront.
+    // The workspace can be used again, its next search allocates the memory from scratch.
+    void release(void);
+};
+
+#endif //UTILS_SEARCH_WORKSPACE_H
@@ -0,0 +1,119 @@
+#include <algorithm>
+#include <stdexcept>
+
+#include "VertexOrder.h"
+
+VertexOrder::VertexOrder(const std::vector<uint32_t> &order)
+    : internal_ids(order.size()+1), original_ids(order.size()+1) {
+    this->original_ids[0] = 0;
+    std::copy(order.begin(), order.end(), this->original_ids.begin()+1);
+    for (size_t internal_id = 0; internal_id < this->original_ids.size(); internal_id++) {
+        this->internal_ids[this->original_ids[internal_id]] = internal_id;
+    }
+}
+
+
+VertexOrder VertexOrder::breadth_first(const AdjacencyMatrix &graph, const AdjacencyMatrix &inv_graph) {
+    std::vector<uint32_t> order;
+    order.reserve(graph.size());
+    std::vector<char> visited(graph.size()+1, false);
+    visited[0] = true;
+
+    // order doubles as the queue of the search
+    for (size_t root = 1; root <= graph.size(); root++) {
+        if (visited[root]) {
+            continue;
+        }
+        visited[root] = true;
+        order.push_back(root);
+        for (size_t queue_idx = order.size()-1; queue_idx < order.size(); queue_idx++) {
+            size_t vertex = order[queue_idx];
+            for (const AdjacencyMatrix *adj_matrix : {&graph, &inv_graph}) {
+                const AdjacencyMatrix::OutgoingEdges outgoing_edges = (*adj_matrix)[vertex];
+                for (size_t edge_idx = 0; edge_idx < outgoing_edges.size; edge_idx++) {
+                    size_t next = outgoing_edges.target[edge_idx];
+                    if (visited[next] == false) {
+                        visited[next] = true;
+                        order.push_back(next);
+                    }
+                }
+            }
+        }
+    }
+    return VertexOrder(order);
+}
+
+
+// Distance along a Hilbert curve filling a 2^16 x 2^16 grid
+uint64_t hilbert_distance(uint32_t x, uint32_t y) {
+    uint64_t distance = 0;
+    for (uint32_t side = 1 << 15; side > 0; side >>= 1) {
+        uint32_t rx = (x & side) ? 1 : 0;
+        uint32_t ry = (y & side) ? 1 : 0;
+        distance += uint64_t(side) * side * ((3 * rx) ^ ry);
+        // Rotate the quadrant so the curve within it has the orientation of the whole curve
+        if (ry == 0) {
+            if (rx == 1) {
+                x = side - 1 - (x & (side - 1));
+                y = side - 1 - (y & (side - 1));
+            }
+            std::swap(x, y);
+        }
+    }
+    return distance;
+}
+
+
+VertexOrder VertexOrder::hilbert(size_t graph_size, const std::vector<std::pair<size_t, Pair<int64_t>>> &coordinates) {
+    Pair<int64_t> min_coordinates = {std::numeric_limits<int64_t>::max(), std::numeric_limits<int64_t>::max()};
+    Pair<int64_t> max_coordinates = {std::numeric_limits<int64_t>::min(), std::numeric_limits<int64_t>::min()};
+    for (auto vertex = coordinates.begin(); vertex != coordinates.end(); ++vertex) {
+        if ((vertex->first == 0) || (vertex->first > graph_size)) {
+            throw std::out_of_range("Coordinates of a vertex outside of the graph");
+        }
+        for (size_t i = 0; i < 2; i++) {
+            min_coordinates[i] = std::min(min_coordinates[i], vertex->second[i]);
+            max_coordinates[i] = std::max(max_coordinates[i], vertex->second[i]);
+        }
+    }
+
+    // Vertices without coordinates keep the maximal distance, the stable sort leaves them in id order
+    std::vector<uint64_t> distances(graph_size+1, std::numeric_limits<uint64_t>::max());
+    for (auto vertex = coordinates.begin(); vertex != coordinates.end(); ++vertex) {
+        Pair<uint32_t> cell;
+        for (size_t i = 0; i < 2; i++) {
+            double extent = std::max<double>(1, double(max_coordinates[i]) - min_coordinates[i]);
+            cell[i] = uint32_t((double(vertex->second[i]) - min_coordinates[i]) / extent * 0xFFFF);
+        }
+        distances[vertex->first] = hilbert_distance(cell[0], cell[1]);
+    }
+
+    std::vector<uint32_t> order(graph_size);
+    for (size_t vertex_id = 1; vertex_id <= graph_size; vertex_id++) {
+        order[vertex_id-1] = vertex_id;
+    }
+    std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+        return distances[a] < distances[b];
+    });
+    return VertexOrder(order);
+}
+
+
+void VertexOrder::reorder(const AdjacencyMatrix &graph, AdjacencyMatrix &reordered_graph,
+                          AdjacencyMatrix &reordered_inv_graph) const {
+    if ((this->internal_ids.empty() == false) && (this->internal_ids.size() != graph.size()+1)) {
+        throw std::invalid_argument("Vertex order was built for a graph of another size");
+    }
+
+    std::vector<Edge> edges;
+    edges.reserve(graph.edges_count());
+    for (size_t internal_id = 0; internal_id <= graph.size(); internal_id++) {
+        size_t vertex_id = this->to_original(internal_id);
+        const AdjacencyMatrix::OutgoingEdges outgoing_edges = graph[vertex_id];
+        for (size_t edge_idx = 0; edge_idx < outgoing_edges.size; edge_idx++) {
+            edges.emplace_back(internal_id, this->to_internal(outgoing_edges.target[edge_idx]),
+                               Pair<size_t>({outgoing_edges.cost[0][edge_idx], outgoing_edges.cost[1][edge_idx]}));
+        }
+    }
+    AdjacencyMatrix::build_with_inverse(graph.size(), edges, reordered_graph, reordered_inv_graph);
+}
@@ -0,0 +1,44 @@
+#ifndef UTILS_VERTEX_ORDER_H
+#define UTILS_VERTEX_ORDER_H
+
+#include <vector>
+#include <cstdint>
+#include <utility>
+#include "Definitions.h"
+
+// Renumbering of the vertices of a graph that keeps vertices close in the graph close in memory.
+// The ids of the DIMACS files are in arbitrary order, so the adjacency lists and the per vertex
+// arrays of the searches (min_g2, the open path pairs of PPQueue, the heuristic tables) are read
+// at random. Searching the reordered graph reads nearby entries instead.
+// Queries are translated with to_internal(), result vertices back with to_original().
+// Vertex 0, unused by the 1-based DIMACS ids, keeps its id.
+class VertexOrder {
+private:
+    std::vector<uint32_t>   internal_ids;
+    std::vector<uint32_t>   original_ids;
+
+    // Builds the order from the original ids listed in their new order, 0 excluded
+    explicit VertexOrder(const std::vector<uint32_t> &order);
+
+public:
+    // Identity order
+    VertexOrder() = default;
+
+    // Breadth first order over the edges in both directions, from the lowest unvisited id of each component
+    static VertexOrder breadth_first(const AdjacencyMatrix &graph, const AdjacencyMatrix &inv_graph);
+    // Order along a Hilbert curve over the vertex coordinates, i.e. of a DIMACS co file.
+    // Vertices without coordinates go last, in id order.
+    static VertexOrder hilbert(size_t graph_size, const std::vector<std::pair<size_t, Pair<int64_t>>> &coordinates);
+
+    size_t to_internal(size_t vertex_id) const {
+        return this->internal_ids.empty() ? vertex_id : this->internal_ids[vertex_id];
+    }
+    size_t to_original(size_t vertex_id) const {
+        return this->original_ids.empty() ? vertex_id : this->original_ids[vertex_id];
+    }
+
+    // Renumbered copy of the graph and its inverse, the outgoing edges of each vertex keep their order
+    void reorder(const AdjacencyMatrix &graph, AdjacencyMatrix &reordered_graph, AdjacencyMatrix &reordered_inv_graph) const;
+};
+
+#endif //UTILS_VERTEX_ORDER_H
@@ -0,0 +1,72 @@
+#include <algorithm>
+#include "WorkerTeam.h"
+
+
+WorkerTeam::WorkerTeam(size_t workers_amount) {
+    if (workers_amount == 0) {
+        workers_amount = std::max<size_t>(1, std::thread::hardware_concurrency());
+    }
+    for (size_t worker_idx = 1; worker_idx < workers_amount; worker_idx++) {
+        this->threads.emplace_back(&WorkerTeam::work, this, worker_idx);
+    }
+}
+
+
+WorkerTeam::~WorkerTeam() {
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->stopping = true;
+    }
+    this->start_cv.notify_all();
+    for (auto thread = this->threads.begin(); thread != this->threads.end(); ++thread) {
+        thread->join();
+    }
+}
+
+
+void WorkerTeam::work(size_t worker_idx) {
+    uint64_t last_round = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(this->mutex);
+            this->start_cv.wait(lock, [&]() {return this->stopping || (this->round != last_round);});
+            if (this->stopping) {
+                return;
+            }
+            last_round = this->round;
+        }
+
+        this->task(worker_idx);
+
+        std::lock_guard<std::mutex> lock(this->mutex);
+        if (--this->running == 0) {
+            this->done_cv.notify_one();
+        }
+    }
+}
+
+
+void WorkerTeam::run(const std::function<void(size_t)> &task) {
+    if (this->threads.empty()) {
+        task(0);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->task = task;
+        this->running = this->threads.size();
+        this->round++;
+    }
+    this->start_cv.notify_all();
+
+    task(0);
+
+    std::unique_lock<std::mutex> lock(this->mutex);
+    this->done_cv.wait(lock, [&]() {return this->running == 0;});
+}
+
+
+size_t WorkerTeam::size(void) const {
+    return this->threads.size()+1;
+}
@@ -0,0 +1,38 @@
+#ifndef UTILS_WORKER_TEAM_H
+#define UTILS_WORKER_TEAM_H
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <cstdint>
+
+// Fixed set of threads that run a task together, over and over. The calling thread takes part
+// as worker 0, so a team of a single worker runs the task inline without any synchronization.
+class WorkerTeam {
+private:
+    std::vector<std::thread>            threads;
+    std::mutex                          mutex;
+    std::condition_variable             start_cv;
+    std::condition_variable             done_cv;
+    std::function<void(size_t)>         task;
+    uint64_t                            round       = 0;
+    size_t                              running     = 0;
+    bool                                stopping    = false;
+
+    void work(size_t worker_idx);
+
+public:
+    // workers_amount=0 uses all available cores
+    WorkerTeam(size_t workers_amount);
+    ~WorkerTeam();
+    WorkerTeam(const WorkerTeam &) = delete;
+    WorkerTeam &operator=(const WorkerTeam &) = delete;
+
+    // Runs task(worker_idx) on every worker and returns once all of them finished
+    void run(const std::function<void(size_t)> &task);
+    size_t size(void) const;
+};
+
+#endif //UTILS_WORKER_TEAM_H
@@ -5,12 +5,13 @@ import os
 import itertools
 import pandas as pd
 
+from log_converter import load_log
+
 
 def analyize_averages(filename, output_format="csv"):
     analysis = {}
 
-    with open(filename, "r") as file:
-        logs = json.load(file)
+    logs = load_log(filename)
 
     for log in logs:
         algo = log["search_info"]["name"]
@@ -38,6 +39,18 @@ def analyize_averages(filename, output_format="csv"):
         analysis[eps][algo]["max_runtime"] = max(analysis[eps][algo]["max_runtime"], log["total_runtime(ms)"])
         analysis[eps][algo]["queries_count"] += 1
 
+        # Search stats are summed per counter and averaged below. The status is counted per value,
+        # and the eps achieved by relaxed searches is kept as its maximum since its sum means nothing.
+        for stat, value in log["finish_info"].get("stats", {}).items():
+            if stat == "status":
+                stat_key = f"status_{value}_count"
+                analysis[eps][algo][stat_key] = analysis[eps][algo].get(stat_key, 0) + 1
+            elif stat == "achieved_eps":
+                analysis[eps][algo]["max_achieved_eps"] = max(analysis[eps][algo].get("max_achieved_eps", 0), value)
+            elif isinstance(value, (int, float)):
+                stat_key = f"total_{stat}"
+                analysis[eps][algo][stat_key] = analysis[eps][algo].get(stat_key, 0) + value
+
 
     for eps in analysis:
         for algo in analysis[eps]:
@@ -46,6 +59,12 @@ def analyize_averages(filename, output_format="csv"):
             analysis[eps][algo]["avg_runtime"] = \
                 analysis[eps][algo]["total_runtime"]/analysis[eps][algo]["queries_count"]
 
+            stat_keys = [key for key in analysis[eps][algo] if key.startswith("total_") and
+                         key not in ("total_solutions", "total_runtime")]
+            for stat_key in stat_keys:
+                analysis[eps][algo][f"avg_{stat_key[len('total_'):]}"] = \
+                    analysis[eps][algo][stat_key]/analysis[eps][algo]["queries_count"]
+
         analysis[eps]["avg_speedup"] = calc_avg_speedup(analysis[eps])
 
 
@@ -0,0 +1,31 @@
+import json
+import argparse
+
+
+def load_log(filename):
+    # Loads the records of a log in either the JSON list or the NDJSON format
+    with open(filename, "r") as file:
+        content = file.read()
+
+    if content.lstrip().startswith("["):
+        return json.loads(content)
+
+    return [json.loads(line) for line in content.splitlines() if line.strip() != ""]
+
+
+def convert_log(input_filename, output_filename):
+    # Writes the log as a JSON list, the format test.py and log_analyser.py read
+    logs = load_log(input_filename)
+
+    with open(output_filename, "w") as file:
+        file.write(json.dumps(logs, indent=4))
+
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser(description="Convert NDJSON search logs into a JSON list log")
+    parser.add_argument("input_filename")
+    parser.add_argument("output_filename")
+
+    args = parser.parse_args()
+    convert_log(args.input_filename, args.output_filename)
@@ -0,0 +1,44 @@
+#ifndef TEST_RANDOM_GRAPHS_H
+#define TEST_RANDOM_GRAPHS_H
+
+#include <vector>
+#include <random>
+#include "../src/Utils/Definitions.h"
+
+// Grid with edges in both directions and conflicting costs, which makes the Pareto fronts large.
+// The first two costs of an edge add up to about 101, the further ones are independent.
+template<size_t N>
+void random_grid(size_t width, size_t height, std::mt19937 &generator, BasicAdjacencyMatrix<N> &graph,
+                 BasicAdjacencyMatrix<N> &inv_graph) {
+    std::uniform_int_distribution<size_t> cost(1, 100);
+    std::uniform_int_distribution<size_t> noise(0, 20);
+    std::vector<BasicEdge<N>> edges;
+    auto random_cost = [&]() {
+        Costs<size_t, N> edge_cost;
+        edge_cost[0] = cost(generator);
+        edge_cost[1] = 101-edge_cost[0]+noise(generator);
+        for (size_t i = 2; i < N; i++) {
+            edge_cost[i] = cost(generator);
+        }
+        return edge_cost;
+    };
+    auto add_edges = [&](size_t a, size_t b) {
+        edges.push_back({a, b, random_cost()});
+        edges.push_back({b, a, random_cost()});
+    };
+    for (size_t y = 0; y < height; y++) {
+        for (size_t x = 0; x < width; x++) {
+            // Vertex ids are 1-based
+            size_t vertex_id = y*width + x + 1;
+            if (x+1 < width) {
+                add_edges(vertex_id, vertex_id+1);
+            }
+            if (y+1 < height) {
+                add_edges(vertex_id, vertex_id+width);
+            }
+        }
+    }
+    BasicAdjacencyMatrix<N>::build_with_inverse(width*height, edges, graph, inv_graph);
+}
+
+#endif // TEST_RANDOM_GRAPHS_H
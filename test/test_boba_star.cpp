@@ -0,0 +1,106 @@
+#include <iostream>
+#include <vector>
+#include <random>
+#include <algorithm>
+
+#include "../src/Utils/Definitions.h"
+#include "../src/Example/ShortestPathHeuristic.h"
+#include "../src/BiCriteria/BOAStar.h"
+#include "../src/BiCriteria/BOBAStar.h"
+#include "RandomGraphs.h"
+
+// Checks BOBAStar against the exact Pareto front of BOAStar on random grids, alternating its directions
+// and running them concurrently, with and without early solution detection (heuristics with paths).
+// Its solutions must have the costs of the front in increasing c1 order, and be paths of the graph from
+// source to target with those costs, including the ones completed by heuristic paths.
+
+
+std::vector<Pair<size_t>> solution_costs(const SolutionSet &solutions) {
+    std::vector<Pair<size_t>> costs;
+    for (auto solution = solutions.begin(); solution != solutions.end(); ++solution) {
+        costs.push_back({(*solution)->g[0], (*solution)->g[1]});
+    }
+    return costs;
+}
+
+
+// Amount of solutions whose path through their parents is not a path of the graph with their costs
+size_t invalid_paths(const AdjacencyMatrix &graph, const SolutionSet &solutions, const NodePool &nodes,
+                     size_t source, size_t target) {
+    size_t invalid = 0;
+    for (auto solution = solutions.begin(); solution != solutions.end(); ++solution) {
+        const Node *node = *solution;
+        Pair<size_t> costs = {0, 0};
+        bool valid = (node->id == target);
+        for (; valid && (node->parent != NULL_HANDLE); node = &nodes[node->parent]) {
+            const Node &parent = nodes[node->parent];
+            const AdjacencyMatrix::OutgoingEdges outgoing_edges = graph[parent.id];
+            size_t edge_idx = 0;
+            while ((edge_idx < outgoing_edges.size) && (outgoing_edges.target[edge_idx] != node->id)) {
+                edge_idx++;
+            }
+            valid = (edge_idx < outgoing_edges.size);
+            if (valid) {
+                costs[0] += outgoing_edges.cost[0][edge_idx];
+                costs[1] += outgoing_edges.cost[1][edge_idx];
+            }
+        }
+        if ((valid == false) || (node->id != source) ||
+            (costs != Pair<size_t>({(*solution)->g[0], (*solution)->g[1]}))) {
+            invalid++;
+        }
+    }
+    return invalid;
+}
+
+
+int main(void) {
+    const size_t graphs_amount = 8;
+    const size_t queries_amount = 8;
+
+    std::mt19937 generator(20240702);
+    size_t failures = 0;
+    size_t checks = 0;
+
+    for (size_t graph_idx = 0; graph_idx < graphs_amount; graph_idx++) {
+        AdjacencyMatrix graph;
+        AdjacencyMatrix inv_graph;
+        random_grid(24, 24, generator, graph, inv_graph);
+        std::uniform_int_distribution<size_t> vertex(1, graph.size());
+
+        for (size_t query_idx = 0; query_idx < queries_amount; query_idx++) {
+            size_t source = vertex(generator);
+            size_t target = vertex(generator);
+
+            SolutionSet solutions;
+            ShortestPathHeuristic heuristic(target, graph.size(), inv_graph);
+            BOAStar boa_star(graph, {0, 0});
+            boa_star(source, target, heuristic, solutions);
+            std::vector<Pair<size_t>> front = solution_costs(solutions);
+            std::sort(front.begin(), front.end());
+
+            for (int with_paths = 0; with_paths < 2; with_paths++) {
+                ShortestPathHeuristic forward_heuristic(target, graph.size(), inv_graph, false, with_paths);
+                ShortestPathHeuristic backward_heuristic(source, graph.size(), graph, false, with_paths);
+                for (int concurrent = 0; concurrent < 2; concurrent++) {
+                    solutions.clear();
+                    BOBAStar boba_star(graph, inv_graph, nullptr, concurrent);
+                    boba_star(source, target, forward_heuristic, backward_heuristic, solutions);
+                    size_t invalid = invalid_paths(graph, solutions, boba_star.get_nodes(), source, target);
+                    checks++;
+                    if ((solution_costs(solutions) != front) || (invalid > 0)) {
+                        failures++;
+                        std::cout << "FAILED BOBAStar graph " << graph_idx << " query " << source << "->" << target
+                                  << (with_paths ? " with" : " without") << " early solution detection"
+                                  << (concurrent ? " concurrent" : "") << ": " << solutions.size()
+                                  << " solutions and " << invalid << " invalid paths, BOAStar " << front.size()
+                                  << " solutions" << std::endl;
+                    }
+                }
+            }
+        }
+    }
+
+    std::cout << (checks - failures) << "/" << checks << " checks passed" << std::endl;
+    return (failures == 0) ? 0 : 1;
+}
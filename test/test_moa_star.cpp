@@ -0,0 +1,167 @@
+#include <iostream>
+#include <vector>
+#include <random>
+#include <algorithm>
+
+#include "../src/Utils/Definitions.h"
+#include "../src/Example/ShortestPathHeuristic.h"
+#include "../src/Example/IdealPointHeuristic.h"
+#include "../src/BiCriteria/BOAStar.h"
+#include "../src/MultiCriteria/MOAStar.h"
+#include "RandomGraphs.h"
+
+// Checks MOAStar on random grids. With two objectives it must return the Pareto front of BOAStar.
+// With three its solutions must be paths of the graph from source to target with the costs they
+// report, must not dominate each other, and must reach the ideal point in every objective, which
+// the lexicographic optimum of that objective does.
+
+
+template<size_t N>
+std::vector<Costs<size_t, N>> sorted_costs(const typename MOAStar<uint32_t, N>::SolutionsType &solutions) {
+    std::vector<Costs<size_t, N>> costs;
+    for (auto solution = solutions.begin(); solution != solutions.end(); ++solution) {
+        Costs<size_t, N> cost;
+        std::copy((*solution)->g.begin(), (*solution)->g.end(), cost.begin());
+        costs.push_back(cost);
+    }
+    std::sort(costs.begin(), costs.end());
+    return costs;
+}
+
+
+template<size_t N>
+bool weakly_dominates(const Costs<size_t, N> &a, const Costs<size_t, N> &b) {
+    for (size_t i = 0; i < N; i++) {
+        if (a[i] > b[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+
+// Costs of the path of a solution walked through its parents, or MAX_COST if an edge is missing
+template<size_t N>
+Costs<size_t, N> path_costs(const BasicAdjacencyMatrix<N> &graph, const typename MOAStar<uint32_t, N>::NodeType *node,
+                            const typename MOAStar<uint32_t, N>::NodePoolType &nodes, size_t source) {
+    Costs<size_t, N> costs = {};
+    for (; node->parent != NULL_HANDLE; node = &nodes[node->parent]) {
+        const typename MOAStar<uint32_t, N>::NodeType &parent = nodes[node->parent];
+        const typename BasicAdjacencyMatrix<N>::OutgoingEdges outgoing_edges = graph[parent.id];
+        size_t edge_idx = 0;
+        while ((edge_idx < outgoing_edges.size) && (outgoing_edges.target[edge_idx] != node->id)) {
+            edge_idx++;
+        }
+        if (edge_idx == outgoing_edges.size) {
+            costs.fill(MAX_COST);
+            return costs;
+        }
+        for (size_t i = 0; i < N; i++) {
+            costs[i] += outgoing_edges.cost[i][edge_idx];
+        }
+    }
+    if (node->id != source) {
+        costs.fill(MAX_COST);
+    }
+    return costs;
+}
+
+
+int main(void) {
+    const size_t graphs_amount = 8;
+    const size_t queries_amount = 4;
+
+    std::mt19937 generator(20240611);
+    size_t failures = 0;
+    size_t checks = 0;
+
+    for (size_t graph_idx = 0; graph_idx < graphs_amount; graph_idx++) {
+        AdjacencyMatrix graph;
+        AdjacencyMatrix inv_graph;
+        random_grid(16, 16, generator, graph, inv_graph);
+        std::uniform_int_distribution<size_t> vertex(1, graph.size());
+
+        for (size_t query_idx = 0; query_idx < queries_amount; query_idx++) {
+            size_t source = vertex(generator);
+            size_t target = vertex(generator);
+
+            SolutionSet boa_solutions;
+            ShortestPathHeuristic heuristic(target, graph.size(), inv_graph);
+            BOAStar boa_star(graph, {0, 0});
+            boa_star(source, target, heuristic, boa_solutions);
+            std::vector<Pair<size_t>> front;
+            for (auto solution = boa_solutions.begin(); solution != boa_solutions.end(); ++solution) {
+                front.push_back({(*solution)->g[0], (*solution)->g[1]});
+            }
+            std::sort(front.begin(), front.end());
+
+            MOAStar<uint32_t, 2>::SolutionsType solutions;
+            IdealPointHeuristic<2> ideal_point(target, graph.size(), inv_graph);
+            MOAStar<uint32_t, 2> moa_star(graph, {0, 0});
+            moa_star(source, target, ideal_point, solutions);
+            checks++;
+            if (sorted_costs<2>(solutions) != front) {
+                failures++;
+                std::cout << "FAILED MOAStar<2> graph " << graph_idx << " query " << source << "->" << target
+                          << ": " << solutions.size() << " solutions, BOAStar " << front.size() << std::endl;
+            }
+        }
+    }
+
+    for (size_t graph_idx = 0; graph_idx < graphs_amount; graph_idx++) {
+        BasicAdjacencyMatrix<3> graph;
+        BasicAdjacencyMatrix<3> inv_graph;
+        random_grid(12, 12, generator, graph, inv_graph);
+        std::uniform_int_distribution<size_t> vertex(1, graph.size());
+
+        for (size_t query_idx = 0; query_idx < queries_amount; query_idx++) {
+            size_t source = vertex(generator);
+            size_t target = vertex(generator);
+
+            MOAStar<uint32_t, 3>::SolutionsType solutions;
+            IdealPointHeuristic<3> ideal_point(target, graph.size(), inv_graph);
+            MOAStar<uint32_t, 3> moa_star(graph, {0, 0, 0});
+            moa_star(source, target, ideal_point, solutions);
+            std::vector<Costs<size_t, 3>> costs = sorted_costs<3>(solutions);
+
+            size_t invalid_paths = 0;
+            for (auto solution = solutions.begin(); solution != solutions.end(); ++solution) {
+                Costs<size_t, 3> cost;
+                std::copy((*solution)->g.begin(), (*solution)->g.end(), cost.begin());
+                if (path_costs<3>(graph, *solution, moa_star.get_nodes(), source) != cost) {
+                    invalid_paths++;
+                }
+            }
+            size_t dominated = 0;
+            for (size_t i = 0; i < costs.size(); i++) {
+                for (size_t j = 0; j < costs.size(); j++) {
+                    if ((i != j) && weakly_dominates<3>(costs[i], costs[j])) {
+                        dominated++;
+                    }
+                }
+            }
+            size_t missed_ideal = 0;
+            for (size_t cost_idx = 0; cost_idx < 3; cost_idx++) {
+                size_t best = MAX_COST;
+                for (auto cost = costs.begin(); cost != costs.end(); ++cost) {
+                    best = std::min(best, (*cost)[cost_idx]);
+                }
+                if (best != ideal_point(source)[cost_idx]) {
+                    missed_ideal++;
+                }
+            }
+
+            checks++;
+            if (costs.empty() || (invalid_paths > 0) || (dominated > 0) || (missed_ideal > 0)) {
+                failures++;
+                std::cout << "FAILED MOAStar<3> graph " << graph_idx << " query " << source << "->" << target
+                          << ": " << costs.size() << " solutions, " << invalid_paths << " invalid paths, "
+                          << dominated << " dominated, " << missed_ideal << " objectives above the ideal point"
+                          << std::endl;
+            }
+        }
+    }
+
+    std::cout << (checks - failures) << "/" << checks << " checks passed" << std::endl;
+    return (failures == 0) ? 0 : 1;
+}
@@ -0,0 +1,122 @@
+#include <iostream>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <limits>
+
+#include "../src/Utils/Definitions.h"
+#include "../src/Example/ShortestPathHeuristic.h"
+#include "../src/BiCriteria/BOAStar.h"
+#include "../src/BiCriteria/PPA.h"
+#include "../src/BiCriteria/ParallelPPA.h"
+#include "RandomGraphs.h"
+
+// Checks ParallelPPA against PPA, and PPA against the exact Pareto front of BOAStar, on random grids.
+// ParallelPPA must return the solutions of PPA in the same order after as many expansions, for every
+// batch size. PPA must return the front with eps=0. Otherwise every Pareto optimal cost must be within
+// a factor (1+eps)^2 of a solution on both objectives: the solutions are the top left nodes of path
+// pairs whose bottom right nodes are within (1+eps) of them.
+
+
+// Costs of the solutions in the order they were returned
+std::vector<Pair<size_t>> solution_costs(const SolutionSet &solutions) {
+    std::vector<Pair<size_t>> costs;
+    for (auto solution = solutions.begin(); solution != solutions.end(); ++solution) {
+        costs.push_back({(*solution)->g[0], (*solution)->g[1]});
+    }
+    return costs;
+}
+
+
+std::vector<Pair<size_t>> sorted_costs(const SolutionSet &solutions) {
+    std::vector<Pair<size_t>> costs = solution_costs(solutions);
+    std::sort(costs.begin(), costs.end());
+    costs.erase(std::unique(costs.begin(), costs.end()), costs.end());
+    return costs;
+}
+
+
+// Largest relative excess over the front of the solution covering a Pareto optimal cost best
+double max_excess(const std::vector<Pair<size_t>> &front, const std::vector<Pair<size_t>> &costs) {
+    double worst = 0;
+    for (auto optimal = front.begin(); optimal != front.end(); ++optimal) {
+        double best = std::numeric_limits<double>::max();
+        for (auto cost = costs.begin(); cost != costs.end(); ++cost) {
+            double excess = std::max(double((*cost)[0])/(*optimal)[0], double((*cost)[1])/(*optimal)[1]) - 1;
+            best = std::min(best, excess);
+        }
+        worst = std::max(worst, best);
+    }
+    return worst;
+}
+
+
+int main(void) {
+    const std::vector<double> eps_values = {0, 0.01, 0.05, 0.2};
+    const std::vector<size_t> batch_sizes = {1, 8, 64, 256};
+    const size_t graphs_amount = 8;
+    const size_t queries_amount = 4;
+
+    std::mt19937 generator(20240517);
+    size_t failures = 0;
+    size_t checks = 0;
+    std::vector<double> worst_excess(eps_values.size(), 0);
+
+    for (size_t graph_idx = 0; graph_idx < graphs_amount; graph_idx++) {
+        AdjacencyMatrix graph;
+        AdjacencyMatrix inv_graph;
+        random_grid(24, 24, generator, graph, inv_graph);
+        std::uniform_int_distribution<size_t> vertex(1, graph.size());
+
+        for (size_t query_idx = 0; query_idx < queries_amount; query_idx++) {
+            size_t source = vertex(generator);
+            size_t target = vertex(generator);
+            ShortestPathHeuristic heuristic(target, graph.size(), inv_graph);
+
+            SolutionSet solutions;
+            BOAStar boa_star(graph, {0, 0});
+            boa_star(source, target, heuristic, solutions);
+            std::vector<Pair<size_t>> front = sorted_costs(solutions);
+
+            for (size_t eps_idx = 0; eps_idx < eps_values.size(); eps_idx++) {
+                double eps = eps_values[eps_idx];
+                double bound = (1+eps)*(1+eps) - 1;
+
+                solutions.clear();
+                PPA ppa(graph, {eps, eps});
+                ppa(source, target, heuristic, solutions);
+                std::vector<Pair<size_t>> ppa_costs = solution_costs(solutions);
+                double excess = max_excess(front, ppa_costs);
+                worst_excess[eps_idx] = std::max(worst_excess[eps_idx], excess);
+                checks++;
+                if ((eps == 0) ? (sorted_costs(solutions) != front) : (excess > bound + 1e-9)) {
+                    failures++;
+                    std::cout << "FAILED PPA graph " << graph_idx << " query " << source << "->" << target
+                              << " eps " << eps << ": excess " << excess << std::endl;
+                }
+
+                for (auto batch_size = batch_sizes.begin(); batch_size != batch_sizes.end(); ++batch_size) {
+                    solutions.clear();
+                    ParallelPPA parallel_ppa(graph, {eps, eps}, nullptr, 4, *batch_size);
+                    parallel_ppa(source, target, heuristic, solutions);
+                    checks++;
+                    if ((solution_costs(solutions) != ppa_costs) ||
+                        (parallel_ppa.get_stats().nodes_expanded != ppa.get_stats().nodes_expanded)) {
+                        failures++;
+                        std::cout << "FAILED ParallelPPA graph " << graph_idx << " query " << source << "->" << target
+                                  << " eps " << eps << " batch " << *batch_size << ": " << solutions.size()
+                                  << " solutions and " << parallel_ppa.get_stats().nodes_expanded
+                                  << " expansions, PPA " << ppa_costs.size() << " and "
+                                  << ppa.get_stats().nodes_expanded << std::endl;
+                    }
+                }
+            }
+        }
+    }
+
+    for (size_t eps_idx = 0; eps_idx < eps_values.size(); eps_idx++) {
+        std::cout << "eps " << eps_values[eps_idx] << ": worst excess " << worst_excess[eps_idx] << std::endl;
+    }
+    std::cout << (checks - failures) << "/" << checks << " checks passed" << std::endl;
+    return (failures == 0) ? 0 : 1;
+}